@@ -0,0 +1,185 @@
+#include "BVH.h"
+#include <algorithm>
+#include <cmath>
+
+static const int MAX_LEAF_ITEMS = 4;
+
+BVH::BVH() {
+}
+
+void BVH::clear() {
+    items.clear();
+    itemOrder.clear();
+    nodes.clear();
+}
+
+void BVH::addBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ) {
+    Bounds b;
+    b.min[0] = minX; b.min[1] = minY; b.min[2] = minZ;
+    b.max[0] = maxX; b.max[1] = maxY; b.max[2] = maxZ;
+    items.push_back(b);
+}
+
+void BVH::build() {
+    nodes.clear();
+    itemOrder.resize(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        itemOrder[i] = static_cast<int>(i);
+    }
+    if (items.empty()) return;
+    
+    nodes.reserve(items.size() * 2);  // Upper bound for a binary tree over n items
+    buildNode(0, static_cast<int>(items.size()));  // Root ends up at index 0
+}
+
+// Builds the subtree over itemOrder[first .. first + count) and returns its node
+int BVH::buildNode(int first, int count) {
+    int nodeIndex = static_cast<int>(nodes.size());
+    nodes.push_back(Node());
+    
+    // Bounds of the items, and of their centers to choose the split
+    Bounds bounds = items[itemOrder[first]];
+    Bounds centers;
+    for (int a = 0; a < 3; a++) {
+        centers.min[a] = centers.max[a] = (bounds.min[a] + bounds.max[a]) * 0.5f;
+    }
+    for (int i = first; i < first + count; i++) {
+        const Bounds& b = items[itemOrder[i]];
+        for (int a = 0; a < 3; a++) {
+            bounds.min[a] = std::min(bounds.min[a], b.min[a]);
+            bounds.max[a] = std::max(bounds.max[a], b.max[a]);
+            float c = (b.min[a] + b.max[a]) * 0.5f;
+            centers.min[a] = std::min(centers.min[a], c);
+            centers.max[a] = std::max(centers.max[a], c);
+        }
+    }
+    
+    int axis = 0;
+    for (int a = 1; a < 3; a++) {
+        if (centers.max[a] - centers.min[a] > centers.max[axis] - centers.min[axis]) axis = a;
+    }
+    
+    Node node;
+    node.bounds = bounds;
+    node.left = node.right = -1;
+    node.first = first;
+    node.count = count;
+    
+    // Small or inseparable sets become leaves
+    if (count > MAX_LEAF_ITEMS && centers.max[axis] > centers.min[axis]) {
+        // Median split along the axis where the centers spread most
+        int half = count / 2;
+        std::nth_element(itemOrder.begin() + first, itemOrder.begin() + first + half,
+                         itemOrder.begin() + first + count,
+                         [this, axis](int a, int b) {
+                             return items[a].min[axis] + items[a].max[axis] <
+                                    items[b].min[axis] + items[b].max[axis];
+                         });
+        node.left = buildNode(first, half);
+        node.right = buildNode(first + half, count - half);
+        node.count = 0;
+    }
+    
+    nodes[nodeIndex] = node;
+    return nodeIndex;
+}
+
+// Slab test; returns the entry distance, or a negative value on a miss
+static float rayEnterBounds(const float origin[3], const float invDir[3],
+                            const float bmin[3], const float bmax[3], float maxT, int* hitAxis) {
+    float tEnter = 0.0f, tExit = maxT;
+    int axis = -1;
+    for (int a = 0; a < 3; a++) {
+        float t1 = (bmin[a] - origin[a]) * invDir[a];
+        float t2 = (bmax[a] - origin[a]) * invDir[a];
+        if (std::isnan(t1) || std::isnan(t2)) {
+            continue;  // Parallel and exactly on the slab plane: inside this slab
+        }
+        if (t1 > t2) std::swap(t1, t2);
+        if (t1 > tEnter) {
+            tEnter = t1;
+            axis = a;
+        }
+        if (t2 < tExit) tExit = t2;
+        if (tEnter > tExit) return -1.0f;
+    }
+    if (hitAxis) *hitAxis = axis;
+    return tEnter;
+}
+
+bool BVH::castRay(const float origin[3], const float dir[3], float maxT, RayHit& hit) const {
+    if (nodes.empty()) return false;
+    
+    // Zero components become infinities, which the slab test handles
+    float invDir[3];
+    for (int a = 0; a < 3; a++) {
+        invDir[a] = 1.0f / dir[a];
+    }
+    
+    float bestT = maxT;
+    int bestIndex = -1;
+    int bestAxis = -1;
+    
+    // Median splits keep the tree depth below 32, so the stack can't overflow
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (rayEnterBounds(origin, invDir, node.bounds.min, node.bounds.max, bestT, nullptr) < 0.0f) {
+            continue;
+        }
+        
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; i++) {
+                const Bounds& b = items[itemOrder[i]];
+                int axis = -1;
+                float t = rayEnterBounds(origin, invDir, b.min, b.max, bestT, &axis);
+                if (t >= 0.0f && (bestIndex < 0 || t < bestT)) {
+                    bestT = t;
+                    bestIndex = itemOrder[i];
+                    bestAxis = axis;
+                }
+            }
+            continue;
+        }
+        
+        // Visit the nearer child first so the far one is often pruned
+        int nearChild = node.left, farChild = node.right;
+        const Node& l = nodes[node.left];
+        const Node& r = nodes[node.right];
+        float dl = 0.0f, dr = 0.0f;
+        for (int a = 0; a < 3; a++) {
+            dl += (l.bounds.min[a] + l.bounds.max[a] - r.bounds.min[a] - r.bounds.max[a]) * dir[a];
+        }
+        if (dl > dr) std::swap(nearChild, farChild);
+        stack[top++] = farChild;
+        stack[top++] = nearChild;
+    }
+    
+    if (bestIndex < 0) return false;
+    hit.t = bestT;
+    hit.index = bestIndex;
+    hit.nx = hit.ny = hit.nz = 0.0f;
+    if (bestAxis >= 0) {
+        // The ray entered through the face on this axis, facing back at it
+        float n = dir[bestAxis] > 0.0f ? -1.0f : 1.0f;
+        if (bestAxis == 0) hit.nx = n;
+        else if (bestAxis == 1) hit.ny = n;
+        else hit.nz = n;
+    }
+    return true;
+}
+
+bool BVH::raycast(float ox, float oy, float oz, float dx, float dy, float dz,
+                  float maxDistance, RayHit& hit) const {
+    const float origin[3] = { ox, oy, oz };
+    const float dir[3] = { dx, dy, dz };
+    return castRay(origin, dir, maxDistance, hit);
+}
+
+bool BVH::segmentCast(float x0, float y0, float z0, float x1, float y1, float z1, RayHit& hit) const {
+    const float origin[3] = { x0, y0, z0 };
+    const float dir[3] = { x1 - x0, y1 - y0, z1 - z0 };
+    return castRay(origin, dir, 1.0f, hit);
+}
@@ -0,0 +1,57 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include <vector>
+
+// Nearest hit of a ray or segment cast
+struct RayHit {
+    float t;            // Distance along the ray, or fraction of the segment
+    int index;          // Item index as given to build()
+    float nx, ny, nz;   // Surface normal of the face that was hit
+    
+    RayHit() : t(0), index(-1), nx(0), ny(0), nz(0) {}
+};
+
+// Bounding volume hierarchy over axis-aligned boxes, for ray queries.
+// Built once from a list of bounds; queries visit O(log n) nodes for rays
+// that pass few boxes.
+class BVH {
+private:
+    struct Bounds {
+        float min[3];
+        float max[3];
+    };
+    
+    struct Node {
+        Bounds bounds;
+        int left, right;    // Child nodes (inner nodes only)
+        int first, count;   // Range in itemOrder (leaves only; count 0 = inner)
+    };
+    
+    std::vector<Bounds> items;
+    std::vector<int> itemOrder;     // Item indices, grouped by leaf
+    std::vector<Node> nodes;
+    
+    int buildNode(int first, int count);
+    bool castRay(const float origin[3], const float dir[3], float maxT, RayHit& hit) const;
+
+public:
+    BVH();
+    
+    void clear();
+    void addBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ);
+    void build();
+    
+    // Nearest box hit by the ray origin + t * dir with 0 <= t <= maxDistance.
+    // dir does not need to be normalized; t is in units of dir.
+    bool raycast(float ox, float oy, float oz, float dx, float dy, float dz,
+                 float maxDistance, RayHit& hit) const;
+    
+    // Nearest box hit on the segment from (x0, y0, z0) to (x1, y1, z1);
+    // hit.t is the fraction of the way along it
+    bool segmentCast(float x0, float y0, float z0, float x1, float y1, float z1, RayHit& hit) const;
+    
+    int getNodeCount() const { return static_cast<int>(nodes.size()); }
+};
+
+#endif // BVH_H
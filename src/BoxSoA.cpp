@@ -0,0 +1,187 @@
+#include "BoxSoA.h"
+#include "Obstacle.h"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define BOX_SOA_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BOX_SOA_SSE2 1
+#endif
+
+// Padding boxes sit here; their distance to any real point overflows to
+// infinity, which is never less than radius squared
+static const float FAR_AWAY = 1e30f;
+
+BoxSoA::BoxSoA() : minX(nullptr), minY(nullptr), minZ(nullptr),
+                   maxX(nullptr), maxY(nullptr), maxZ(nullptr),
+                   count(0), paddedCount(0) {
+}
+
+void BoxSoA::clear() {
+    storage.clear();
+    minX = minY = minZ = maxX = maxY = maxZ = nullptr;
+    count = paddedCount = 0;
+}
+
+void BoxSoA::assign(const std::vector<Box>& boxes) {
+    count = boxes.size();
+    paddedCount = (count + BATCH - 1) / BATCH * BATCH;
+    
+    // One block for all six arrays plus slack to align the start to 32 bytes.
+    // paddedCount is a multiple of 8 floats, so every array stays aligned.
+    storage.assign(paddedCount * 6 + 8, FAR_AWAY);
+    float* base = &storage[0];
+    uintptr_t misalign = reinterpret_cast<uintptr_t>(base) & 31;
+    if (misalign != 0) {
+        base += (32 - misalign) / sizeof(float);
+    }
+    minX = base;
+    minY = base + paddedCount;
+    minZ = base + paddedCount * 2;
+    maxX = base + paddedCount * 3;
+    maxY = base + paddedCount * 4;
+    maxZ = base + paddedCount * 5;
+    
+    // Same bounds Box::checkCollision derives from center and size
+    for (size_t i = 0; i < count; i++) {
+        const Box& box = boxes[i];
+        float halfW = box.width / 2;
+        float halfD = box.depth / 2;
+        minX[i] = box.x - halfW;
+        maxX[i] = box.x + halfW;
+        minY[i] = box.y;
+        maxY[i] = box.y + box.height;
+        minZ[i] = box.z - halfD;
+        maxZ[i] = box.z + halfD;
+    }
+}
+
+// ===== Scalar reference =====
+
+static inline bool sphereOverlapsBox(float px, float py, float pz, float radius,
+                                     float x0, float y0, float z0,
+                                     float x1, float y1, float z1) {
+    float closestX = std::max(x0, std::min(px, x1));
+    float closestY = std::max(y0, std::min(py, y1));
+    float closestZ = std::max(z0, std::min(pz, z1));
+    float dx = px - closestX;
+    float dy = py - closestY;
+    float dz = pz - closestZ;
+    return dx * dx + dy * dy + dz * dz < radius * radius;
+}
+
+// ===== SIMD kernels =====
+// Each returns a bit mask of the lanes whose box overlaps the sphere
+
+#if defined(BOX_SOA_AVX)
+static inline int overlapMask(__m256 px, __m256 py, __m256 pz, __m256 r2,
+                              __m256 x0, __m256 y0, __m256 z0,
+                              __m256 x1, __m256 y1, __m256 z1) {
+    __m256 dx = _mm256_sub_ps(px, _mm256_max_ps(_mm256_min_ps(px, x1), x0));
+    __m256 dy = _mm256_sub_ps(py, _mm256_max_ps(_mm256_min_ps(py, y1), y0));
+    __m256 dz = _mm256_sub_ps(pz, _mm256_max_ps(_mm256_min_ps(pz, z1), z0));
+    __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                              _mm256_mul_ps(dz, dz));
+    return _mm256_movemask_ps(_mm256_cmp_ps(d2, r2, _CMP_LT_OQ));
+}
+#elif defined(BOX_SOA_SSE2)
+static inline int overlapMask(__m128 px, __m128 py, __m128 pz, __m128 r2,
+                              __m128 x0, __m128 y0, __m128 z0,
+                              __m128 x1, __m128 y1, __m128 z1) {
+    __m128 dx = _mm_sub_ps(px, _mm_max_ps(_mm_min_ps(px, x1), x0));
+    __m128 dy = _mm_sub_ps(py, _mm_max_ps(_mm_min_ps(py, y1), y0));
+    __m128 dz = _mm_sub_ps(pz, _mm_max_ps(_mm_min_ps(pz, z1), z0));
+    __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                           _mm_mul_ps(dz, dz));
+    return _mm_movemask_ps(_mm_cmplt_ps(d2, r2));
+}
+#endif
+
+bool BoxSoA::anySphereOverlap(float px, float py, float pz, float radius) const {
+#if defined(BOX_SOA_AVX)
+    __m256 vx = _mm256_set1_ps(px), vy = _mm256_set1_ps(py), vz = _mm256_set1_ps(pz);
+    __m256 r2 = _mm256_set1_ps(radius * radius);
+    for (size_t i = 0; i < paddedCount; i += 8) {
+        if (overlapMask(vx, vy, vz, r2,
+                        _mm256_load_ps(minX + i), _mm256_load_ps(minY + i), _mm256_load_ps(minZ + i),
+                        _mm256_load_ps(maxX + i), _mm256_load_ps(maxY + i), _mm256_load_ps(maxZ + i))) {
+            return true;
+        }
+    }
+    return false;
+#elif defined(BOX_SOA_SSE2)
+    __m128 vx = _mm_set1_ps(px), vy = _mm_set1_ps(py), vz = _mm_set1_ps(pz);
+    __m128 r2 = _mm_set1_ps(radius * radius);
+    for (size_t i = 0; i < paddedCount; i += 4) {
+        if (overlapMask(vx, vy, vz, r2,
+                        _mm_load_ps(minX + i), _mm_load_ps(minY + i), _mm_load_ps(minZ + i),
+                        _mm_load_ps(maxX + i), _mm_load_ps(maxY + i), _mm_load_ps(maxZ + i))) {
+            return true;
+        }
+    }
+    return false;
+#else
+    for (size_t i = 0; i < count; i++) {
+        if (sphereOverlapsBox(px, py, pz, radius,
+                              minX[i], minY[i], minZ[i], maxX[i], maxY[i], maxZ[i])) {
+            return true;
+        }
+    }
+    return false;
+#endif
+}
+
+bool BoxSoA::anySphereOverlap(float px, float py, float pz, float radius,
+                              const int* indices, size_t indexCount) const {
+    size_t i = 0;
+    
+    // Gather full batches of candidates into registers; the rest go scalar
+#if defined(BOX_SOA_AVX)
+    __m256 vx = _mm256_set1_ps(px), vy = _mm256_set1_ps(py), vz = _mm256_set1_ps(pz);
+    __m256 r2 = _mm256_set1_ps(radius * radius);
+#define GATHER8(a, k) _mm256_set_ps(a[k[7]], a[k[6]], a[k[5]], a[k[4]], a[k[3]], a[k[2]], a[k[1]], a[k[0]])
+    for (; i + 8 <= indexCount; i += 8) {
+        const int* k = indices + i;
+        if (overlapMask(vx, vy, vz, r2,
+                        GATHER8(minX, k), GATHER8(minY, k), GATHER8(minZ, k),
+                        GATHER8(maxX, k), GATHER8(maxY, k), GATHER8(maxZ, k))) {
+            return true;
+        }
+    }
+#undef GATHER8
+#elif defined(BOX_SOA_SSE2)
+    __m128 vx = _mm_set1_ps(px), vy = _mm_set1_ps(py), vz = _mm_set1_ps(pz);
+    __m128 r2 = _mm_set1_ps(radius * radius);
+#define GATHER4(a, k) _mm_set_ps(a[k[3]], a[k[2]], a[k[1]], a[k[0]])
+    for (; i + 4 <= indexCount; i += 4) {
+        const int* k = indices + i;
+        if (overlapMask(vx, vy, vz, r2,
+                        GATHER4(minX, k), GATHER4(minY, k), GATHER4(minZ, k),
+                        GATHER4(maxX, k), GATHER4(maxY, k), GATHER4(maxZ, k))) {
+            return true;
+        }
+    }
+#undef GATHER4
+#endif
+    for (; i < indexCount; i++) {
+        int k = indices[i];
+        if (sphereOverlapsBox(px, py, pz, radius,
+                              minX[k], minY[k], minZ[k], maxX[k], maxY[k], maxZ[k])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* BoxSoA::getKernelName() {
+#if defined(BOX_SOA_AVX)
+    return "AVX";
+#elif defined(BOX_SOA_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,49 @@
+#ifndef BOX_SOA_H
+#define BOX_SOA_H
+
+#include <cstddef>
+#include <vector>
+
+struct Box;
+
+// Box bounds stored as structure-of-arrays for batched sphere tests.
+// Each axis min/max lives in its own aligned array, padded to a full SIMD
+// batch with boxes far away that never overlap anything.
+//
+// The kernel is picked at compile time:
+// - AVX (8 boxes per step) when built with -mavx (ENABLE_AVX in CMake);
+// - SSE2 (4 boxes per step) on any x86-64 build;
+// - a scalar loop everywhere else.
+// All three give exactly the same answers as Box::checkCollision.
+class BoxSoA {
+public:
+    static const size_t BATCH = 8;  // Padding granularity (widest kernel)
+
+private:
+    std::vector<float> storage;     // Backing memory for the six arrays
+    float* minX; float* minY; float* minZ;
+    float* maxX; float* maxY; float* maxZ;
+    size_t count;                   // Real boxes (without padding)
+    size_t paddedCount;
+
+public:
+    BoxSoA();
+    BoxSoA(const BoxSoA&) = delete;             // Arrays point into storage
+    BoxSoA& operator=(const BoxSoA&) = delete;
+    
+    void assign(const std::vector<Box>& boxes);
+    void clear();
+    size_t size() const { return count; }
+    
+    // Does a sphere overlap any box? (same test as Box::checkCollision)
+    bool anySphereOverlap(float px, float py, float pz, float radius) const;
+    
+    // Same test restricted to the given box indices (e.g. broadphase output)
+    bool anySphereOverlap(float px, float py, float pz, float radius,
+                          const int* indices, size_t indexCount) const;
+    
+    // Name of the compiled kernel ("AVX", "SSE2" or "scalar")
+    static const char* getKernelName();
+};
+
+#endif // BOX_SOA_H
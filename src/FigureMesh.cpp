@@ -0,0 +1,346 @@
+#include "FigureMesh.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include "Gfx.h"
+#include <cmath>
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace FigureMesh {
+
+// Segment counts that get their own meshes; other requests snap to the nearest
+static const int SEGMENT_TIERS[] = {4, 6, 8, 10, 12, 16};
+static const int TIER_COUNT = sizeof(SEGMENT_TIERS) / sizeof(SEGMENT_TIERS[0]);
+static const int DISC_SEGMENTS = 32;
+
+// One entry per tier
+static GLuint sphereLists[TIER_COUNT];
+static GLuint cylinderLists[TIER_COUNT];
+static GLuint lowerCapLists[TIER_COUNT];    // Hemisphere pointing -Y
+static GLuint upperCapLists[TIER_COUNT];    // Hemisphere pointing +Y
+static GLuint discList = 0;
+
+// Torso tubes depend on their proportions, keyed by (taper, height) relative
+// to the top radius and segment tier
+typedef std::pair<std::pair<int, int>, int> TorsoKey;
+static std::map<TorsoKey, GLuint> torsoLists;
+
+static bool meshesInitialized = false;
+static int detailDrop = 0;  // Tiers to step down for distant figures
+
+static int tierIndex(int segments) {
+    int best = 0;
+    for (int i = 1; i < TIER_COUNT; i++) {
+        if (std::abs(SEGMENT_TIERS[i] - segments) < std::abs(SEGMENT_TIERS[best] - segments)) {
+            best = i;
+        }
+    }
+    return std::max(0, best - detailDrop);
+}
+
+// Unit sphere at the origin
+static void buildSphere(int segments) {
+    for (int i = 0; i < segments; i++) {
+        float lat0 = M_PI * (-0.5f + (float)i / segments);
+        float lat1 = M_PI * (-0.5f + (float)(i + 1) / segments);
+        float y0 = std::sin(lat0);
+        float y1 = std::sin(lat1);
+        float r0 = std::cos(lat0);
+        float r1 = std::cos(lat1);
+        
+        Gfx::begin(GL_QUAD_STRIP);
+        for (int j = 0; j <= segments; j++) {
+            float lng = 2 * M_PI * (float)j / segments;
+            float cx = std::cos(lng);
+            float cz = std::sin(lng);
+            
+            Gfx::normal3f(cx * r0, y0, cz * r0);
+            Gfx::vertex3f(cx * r0, y0, cz * r0);
+            Gfx::normal3f(cx * r1, y1, cz * r1);
+            Gfx::vertex3f(cx * r1, y1, cz * r1);
+        }
+        Gfx::end();
+    }
+}
+
+// Open unit cylinder, radius 1, from y = 0 to y = 1
+static void buildCylinder(int segments) {
+    Gfx::begin(GL_QUAD_STRIP);
+    for (int i = 0; i <= segments; i++) {
+        float angle = (i * 2.0f * M_PI) / segments;
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        
+        Gfx::normal3f(c, 0, s);
+        Gfx::vertex3f(c, 0, s);
+        Gfx::vertex3f(c, 1, s);
+    }
+    Gfx::end();
+}
+
+// Unit hemisphere bulging towards +Y (direction = 1) or -Y (direction = -1)
+static void buildHemisphere(int segments, float direction) {
+    int capSegs = segments / 2;
+    if (capSegs < 2) capSegs = 2;
+    
+    for (int i = 0; i < capSegs; i++) {
+        float lat0 = M_PI * 0.5f * (float)i / capSegs;
+        float lat1 = M_PI * 0.5f * (float)(i + 1) / capSegs;
+        
+        Gfx::begin(GL_QUAD_STRIP);
+        for (int j = 0; j <= segments; j++) {
+            float lng = 2 * M_PI * (float)j / segments;
+            float cx = std::cos(lng);
+            float cz = std::sin(lng);
+            
+            for (int k = 0; k < 2; k++) {
+                float lat = (k == 0) ? lat0 : lat1;
+                float r = std::cos(lat);
+                float offset = direction * std::sin(lat);
+                
+                Gfx::normal3f(cx * r, offset, cz * r);
+                Gfx::vertex3f(cx * r, offset, cz * r);
+            }
+        }
+        Gfx::end();
+    }
+}
+
+// Tapered torso with top radius 1, standing on the origin
+static void buildTorso(float bottomRadius, float height, int segments) {
+    float topRadius = 1.0f;
+    int rings = 8;
+    
+    for (int i = 0; i < rings; i++) {
+        float t0 = (float)i / rings;
+        float t1 = (float)(i + 1) / rings;
+        float y0 = height * t0;
+        float y1 = height * t1;
+        float r0 = bottomRadius + (topRadius - bottomRadius) * t0;
+        float r1 = bottomRadius + (topRadius - bottomRadius) * t1;
+        
+        Gfx::begin(GL_QUAD_STRIP);
+        for (int j = 0; j <= segments; j++) {
+            float angle = 2 * M_PI * (float)j / segments;
+            float cx = std::cos(angle);
+            float cz = std::sin(angle);
+            
+            Gfx::normal3f(cx, 0.1f, cz);
+            Gfx::vertex3f(cx * r0, y0, cz * r0);
+            Gfx::vertex3f(cx * r1, y1, cz * r1);
+        }
+        Gfx::end();
+    }
+    
+    // Rounded dome cap on top
+    int capSegs = 6;
+    float capHeight = topRadius * 0.4f;  // How much the dome rises
+    for (int i = 0; i < capSegs; i++) {
+        float lat0 = M_PI * 0.5f * (float)i / capSegs;
+        float lat1 = M_PI * 0.5f * (float)(i + 1) / capSegs;
+        
+        Gfx::begin(GL_QUAD_STRIP);
+        for (int j = 0; j <= segments; j++) {
+            float angle = 2 * M_PI * (float)j / segments;
+            float cx = std::cos(angle);
+            float cz = std::sin(angle);
+            
+            for (int k = 0; k < 2; k++) {
+                float lat = (k == 0) ? lat0 : lat1;
+                float r = std::cos(lat) * topRadius;
+                float yOffset = std::sin(lat) * capHeight;
+                
+                Gfx::normal3f(cx * std::cos(lat), std::sin(lat), cz * std::cos(lat));
+                Gfx::vertex3f(cx * r, height + yOffset, cz * r);
+            }
+        }
+        Gfx::end();
+    }
+}
+
+// Unit disc in the XY plane
+static void buildDisc() {
+    Gfx::begin(GL_TRIANGLE_FAN);
+    Gfx::vertex3f(0, 0, 0);  // Center
+    for (int i = 0; i <= DISC_SEGMENTS; i++) {
+        float angle = (i * 2.0f * M_PI) / DISC_SEGMENTS;
+        Gfx::vertex3f(std::cos(angle), std::sin(angle), 0);
+    }
+    Gfx::end();
+}
+
+static GLuint compile(void (*build)(int), int segments) {
+    GLuint list = Gfx::genLists(1);
+    Gfx::newList(list, GL_COMPILE);
+    build(segments);
+    Gfx::endList();
+    return list;
+}
+
+static void buildLowerCap(int segments) { buildHemisphere(segments, -1.0f); }
+static void buildUpperCap(int segments) { buildHemisphere(segments, 1.0f); }
+
+void init() {
+    if (meshesInitialized) return;
+    
+    for (int i = 0; i < TIER_COUNT; i++) {
+        sphereLists[i] = compile(buildSphere, SEGMENT_TIERS[i]);
+        cylinderLists[i] = compile(buildCylinder, SEGMENT_TIERS[i]);
+        lowerCapLists[i] = compile(buildLowerCap, SEGMENT_TIERS[i]);
+        upperCapLists[i] = compile(buildUpperCap, SEGMENT_TIERS[i]);
+    }
+    
+    discList = Gfx::genLists(1);
+    Gfx::newList(discList, GL_COMPILE);
+    buildDisc();
+    Gfx::endList();
+    
+    meshesInitialized = true;
+}
+
+void cleanup() {
+    if (!meshesInitialized) return;
+    
+    for (int i = 0; i < TIER_COUNT; i++) {
+        Gfx::deleteLists(sphereLists[i], 1);
+        Gfx::deleteLists(cylinderLists[i], 1);
+        Gfx::deleteLists(lowerCapLists[i], 1);
+        Gfx::deleteLists(upperCapLists[i], 1);
+    }
+    Gfx::deleteLists(discList, 1);
+    discList = 0;
+    
+    for (auto& entry : torsoLists) {
+        Gfx::deleteLists(entry.second, 1);
+    }
+    torsoLists.clear();
+    
+    meshesInitialized = false;
+}
+
+bool isInitialized() {
+    return meshesInitialized;
+}
+
+void drawSphere(float x, float y, float z, float radius, int segments) {
+    if (!meshesInitialized) init();
+    
+    Gfx::pushMatrix();
+    Gfx::translatef(x, y, z);
+    Gfx::scalef(radius, radius, radius);
+    Gfx::callList(sphereLists[tierIndex(segments)]);
+    Gfx::popMatrix();
+}
+
+void drawLimb(float x1, float y1, float z1, float x2, float y2, float z2,
+              float radius, int segments) {
+    if (!meshesInitialized) init();
+    
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float dz = z2 - z1;
+    float length = std::sqrt(dx*dx + dy*dy + dz*dz);
+    if (length < 0.001f) return;
+    
+    // Normalize direction
+    dx /= length; dy /= length; dz /= length;
+    
+    // Find perpendicular vectors
+    float px, py, pz;
+    if (std::abs(dy) < 0.9f) {
+        px = -dz; py = 0; pz = dx;
+    } else {
+        px = 1; py = 0; pz = 0;
+    }
+    float pl = std::sqrt(px*px + py*py + pz*pz);
+    px /= pl; py /= pl; pz /= pl;
+    
+    // Second perpendicular
+    float qx = dy * pz - dz * py;
+    float qy = dz * px - dx * pz;
+    float qz = dx * py - dy * px;
+    
+    int tier = tierIndex(segments);
+    
+    // Body: unit cylinder's X/Z map onto the perpendiculars, Y onto the limb axis
+    float body[16] = {
+        px * radius, py * radius, pz * radius, 0,
+        dx * length, dy * length, dz * length, 0,
+        qx * radius, qy * radius, qz * radius, 0,
+        x1, y1, z1, 1
+    };
+    Gfx::pushMatrix();
+    Gfx::multMatrixf(body);
+    Gfx::callList(cylinderLists[tier]);
+    Gfx::popMatrix();
+    
+    // Caps: same basis, but the axis is scaled by the radius
+    float cap[16] = {
+        px * radius, py * radius, pz * radius, 0,
+        dx * radius, dy * radius, dz * radius, 0,
+        qx * radius, qy * radius, qz * radius, 0,
+        x1, y1, z1, 1
+    };
+    Gfx::pushMatrix();
+    Gfx::multMatrixf(cap);
+    Gfx::callList(lowerCapLists[tier]);
+    Gfx::popMatrix();
+    
+    cap[12] = x2; cap[13] = y2; cap[14] = z2;
+    Gfx::pushMatrix();
+    Gfx::multMatrixf(cap);
+    Gfx::callList(upperCapLists[tier]);
+    Gfx::popMatrix();
+}
+
+void drawTorso(float x, float bottomY, float topY, float bottomRadius, float topRadius,
+               int segments) {
+    if (!meshesInitialized) init();
+    if (topRadius <= 0.0f) return;
+    
+    // Shape relative to the top radius, so crouching (uniform scale) reuses the mesh
+    float taper = bottomRadius / topRadius;
+    float height = (topY - bottomY) / topRadius;
+    int tier = tierIndex(segments);
+    TorsoKey key(std::make_pair((int)std::lround(taper * 1000.0f),
+                                (int)std::lround(height * 1000.0f)), tier);
+    
+    std::map<TorsoKey, GLuint>::iterator it = torsoLists.find(key);
+    if (it == torsoLists.end()) {
+        GLuint list = Gfx::genLists(1);
+        Gfx::newList(list, GL_COMPILE);
+        buildTorso(taper, height, SEGMENT_TIERS[tier]);
+        Gfx::endList();
+        it = torsoLists.insert(std::make_pair(key, list)).first;
+    }
+    
+    Gfx::pushMatrix();
+    Gfx::translatef(x, bottomY, 0);
+    Gfx::scalef(topRadius, topRadius, topRadius);
+    Gfx::callList(it->second);
+    Gfx::popMatrix();
+}
+
+void drawDisc(float radius, float z) {
+    if (!meshesInitialized) init();
+    
+    Gfx::pushMatrix();
+    Gfx::translatef(0, 0, z);
+    Gfx::scalef(radius, radius, 1.0f);
+    Gfx::callList(discList);
+    Gfx::popMatrix();
+}
+
+void setDetailDrop(int tiers) {
+    detailDrop = std::max(0, tiers);
+}
+
+} // namespace FigureMesh
@@ -0,0 +1,36 @@
+#ifndef FIGURE_MESH_H
+#define FIGURE_MESH_H
+
+// Precomputed meshes for the player figure (spheres, capsule limbs, torso)
+// Unit meshes are generated once and drawn with a transform, so drawing a
+// figure costs no trigonometry and only a few display list calls per part.
+
+namespace FigureMesh {
+    // Generate all unit meshes (needs a current GL context)
+    void init();
+    
+    // Release the display lists
+    void cleanup();
+    
+    // Check if meshes have been generated
+    bool isInitialized();
+    
+    // Sphere centered at (x, y, z)
+    void drawSphere(float x, float y, float z, float radius, int segments = 12);
+    
+    // Cylinder from point 1 to point 2 with hemispherical caps
+    void drawLimb(float x1, float y1, float z1, float x2, float y2, float z2,
+                  float radius, int segments = 12);
+    
+    // Tapered torso standing on (x, bottomY, 0) with a rounded dome on top
+    void drawTorso(float x, float bottomY, float topY, float bottomRadius, float topRadius,
+                   int segments = 12);
+    
+    // Flat disc in the XY plane at height z (used for the shadow)
+    void drawDisc(float radius, float z = 0.0f);
+    
+    // Use coarser meshes: every requested segment count drops this many tiers
+    void setDetailDrop(int tiers);
+}
+
+#endif // FIGURE_MESH_H
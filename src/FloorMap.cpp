@@ -0,0 +1,101 @@
+#include "FloorMap.h"
+#include <algorithm>
+#include <cmath>
+
+FloorMap::FloorMap(float cellSize)
+    : cellSize(cellSize), originX(0.0f), originZ(0.0f), cellsX(0), cellsZ(0) {
+}
+
+void FloorMap::clear() {
+    surfaces.clear();
+    cellEntries.clear();
+    cellStart.clear();
+    cellsX = cellsZ = 0;
+}
+
+void FloorMap::addSurface(float top, float minX, float minZ, float maxX, float maxZ) {
+    Surface s;
+    s.top = top;
+    s.minX = minX;
+    s.minZ = minZ;
+    s.maxX = maxX;
+    s.maxZ = maxZ;
+    surfaces.push_back(s);
+}
+
+void FloorMap::build() {
+    cellEntries.clear();
+    cellStart.clear();
+    cellsX = cellsZ = 0;
+    if (surfaces.empty()) return;
+    
+    // Grid covers the union of all footprints
+    float minX = surfaces[0].minX, maxX = surfaces[0].maxX;
+    float minZ = surfaces[0].minZ, maxZ = surfaces[0].maxZ;
+    for (const auto& s : surfaces) {
+        minX = std::min(minX, s.minX);
+        maxX = std::max(maxX, s.maxX);
+        minZ = std::min(minZ, s.minZ);
+        maxZ = std::max(maxZ, s.maxZ);
+    }
+    originX = minX;
+    originZ = minZ;
+    cellsX = static_cast<int>(std::floor((maxX - minX) / cellSize)) + 1;
+    cellsZ = static_cast<int>(std::floor((maxZ - minZ) / cellSize)) + 1;
+    
+    // Highest first, so a lookup can stop at the first top it may stand on
+    std::vector<Surface> sorted(surfaces);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Surface& a, const Surface& b) { return a.top > b.top; });
+    
+    // Two passes: count entries per cell, then fill the packed array
+    size_t cellCount = static_cast<size_t>(cellsX) * cellsZ;
+    std::vector<unsigned int> counts(cellCount, 0);
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            cellStart.assign(cellCount + 1, 0);
+            for (size_t i = 0; i < cellCount; i++) {
+                cellStart[i + 1] = cellStart[i] + counts[i];
+                counts[i] = cellStart[i];  // Becomes the write cursor
+            }
+            cellEntries.resize(cellStart[cellCount]);
+        }
+        for (const auto& s : sorted) {
+            int x0 = static_cast<int>(std::floor((s.minX - originX) / cellSize));
+            int x1 = static_cast<int>(std::floor((s.maxX - originX) / cellSize));
+            int z0 = static_cast<int>(std::floor((s.minZ - originZ) / cellSize));
+            int z1 = static_cast<int>(std::floor((s.maxZ - originZ) / cellSize));
+            x0 = std::max(x0, 0); x1 = std::min(x1, cellsX - 1);
+            z0 = std::max(z0, 0); z1 = std::min(z1, cellsZ - 1);
+            for (int cz = z0; cz <= z1; cz++) {
+                for (int cx = x0; cx <= x1; cx++) {
+                    size_t cell = static_cast<size_t>(cz) * cellsX + cx;
+                    if (pass == 0) {
+                        counts[cell]++;
+                    } else {
+                        cellEntries[counts[cell]++] = s;
+                    }
+                }
+            }
+        }
+    }
+}
+
+float FloorMap::getFloorHeight(float x, float z, float currentY) const {
+    if (cellsX == 0) return 0.0f;
+    
+    int cx = static_cast<int>(std::floor((x - originX) / cellSize));
+    int cz = static_cast<int>(std::floor((z - originZ) / cellSize));
+    if (cx < 0 || cx >= cellsX || cz < 0 || cz >= cellsZ) return 0.0f;
+    
+    size_t cell = static_cast<size_t>(cz) * cellsX + cx;
+    for (unsigned int i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+        const Surface& s = cellEntries[i];
+        if (s.top <= 0.0f) break;  // Nothing left above the ground
+        if (currentY >= s.top &&
+            x >= s.minX && x <= s.maxX && z >= s.minZ && z <= s.maxZ) {
+            return s.top;
+        }
+    }
+    return 0.0f;
+}
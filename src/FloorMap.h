@@ -0,0 +1,44 @@
+#ifndef FLOOR_MAP_H
+#define FLOOR_MAP_H
+
+#include <cstddef>
+#include <vector>
+
+// Rasterized floor index over the X/Z plane.
+// Each cell lists the standable box tops that reach into it, highest first,
+// so a floor lookup is one cell plus a short scan.
+class FloorMap {
+private:
+    struct Surface {
+        float top;                      // Y of the box top
+        float minX, minZ, maxX, maxZ;   // Standing footprint (inclusive)
+    };
+    
+    std::vector<Surface> surfaces;      // Added surfaces, before build()
+    
+    // Cell (cx, cz) owns cellEntries[cellStart[i] .. cellStart[i + 1])
+    // with i = cz * cellsX + cx
+    std::vector<Surface> cellEntries;
+    std::vector<unsigned int> cellStart;
+    float cellSize;
+    float originX, originZ;
+    int cellsX, cellsZ;
+
+public:
+    explicit FloorMap(float cellSize = 32.0f);
+    
+    void clear();
+    
+    // Register a box top; the footprint already includes any standing margin
+    void addSurface(float top, float minX, float minZ, float maxX, float maxZ);
+    
+    // Rasterize the added surfaces into cells
+    void build();
+    
+    // Highest top at (x, z) that is not above currentY, or 0 if none is higher
+    float getFloorHeight(float x, float z, float currentY) const;
+    
+    size_t getSurfaceCount() const { return surfaces.size(); }
+};
+
+#endif // FLOOR_MAP_H
@@ -0,0 +1,65 @@
+#include "Frustum.h"
+#include <cmath>
+
+Frustum::Frustum() : valid(false) {
+    for (int i = 0; i < 6; i++) {
+        planes[i][0] = planes[i][1] = planes[i][2] = planes[i][3] = 0.0f;
+    }
+}
+
+void Frustum::extract(const float* projection, const float* view) {
+    // clip = projection * view (column-major)
+    float clip[16];
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) {
+                sum += projection[k * 4 + row] * view[col * 4 + k];
+            }
+            clip[col * 4 + row] = sum;
+        }
+    }
+    
+    // Each plane is row 3 plus or minus one of rows 0-2 (Gribb/Hartmann)
+    for (int i = 0; i < 3; i++) {
+        for (int c = 0; c < 4; c++) {
+            float w = clip[c * 4 + 3];
+            float r = clip[c * 4 + i];
+            planes[i * 2 + 0][c] = w + r;  // Left, bottom, near
+            planes[i * 2 + 1][c] = w - r;  // Right, top, far
+        }
+    }
+    
+    // Normalize so distances are in world units
+    for (int i = 0; i < 6; i++) {
+        float len = std::sqrt(planes[i][0] * planes[i][0] +
+                              planes[i][1] * planes[i][1] +
+                              planes[i][2] * planes[i][2]);
+        if (len > 0.0f) {
+            for (int c = 0; c < 4; c++) {
+                planes[i][c] /= len;
+            }
+        }
+    }
+    
+    valid = true;
+}
+
+bool Frustum::isBoxVisible(float minX, float minY, float minZ,
+                           float maxX, float maxY, float maxZ) const {
+    if (!valid) return true;
+    
+    for (int i = 0; i < 6; i++) {
+        const float* p = planes[i];
+        
+        // Corner furthest along the plane normal
+        float x = p[0] >= 0.0f ? maxX : minX;
+        float y = p[1] >= 0.0f ? maxY : minY;
+        float z = p[2] >= 0.0f ? maxZ : minZ;
+        
+        if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
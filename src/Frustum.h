@@ -0,0 +1,32 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+// Visible/culled object counts for one render pass (for profiling)
+struct CullStats {
+    int visible;
+    int culled;
+    
+    CullStats() : visible(0), culled(0) {}
+    void reset() { visible = 0; culled = 0; }
+};
+
+// View frustum as six planes, extracted from the camera matrices.
+// Until extract() is called every box counts as visible.
+class Frustum {
+private:
+    float planes[6][4];     // a, b, c, d with the normal pointing inside
+    bool valid;
+
+public:
+    Frustum();
+    
+    // Build the planes from column-major projection and view matrices
+    // (the same layout passed to glMultMatrixf)
+    void extract(const float* projection, const float* view);
+    
+    // Conservative test: false only if the box is fully outside one plane
+    bool isBoxVisible(float minX, float minY, float minZ,
+                      float maxX, float maxY, float maxZ) const;
+};
+
+#endif // FRUSTUM_H
@@ -0,0 +1,1004 @@
+#include "Gfx.h"
+#include <GLFW/glfw3.h>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// Core profile enums that GL 1.1 headers don't have
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_RED
+#define GL_RED 0x1903
+#endif
+#ifndef GL_R8
+#define GL_R8 0x8229
+#endif
+
+namespace Gfx {
+
+// ============ CORE PROFILE ENTRY POINTS ============
+// Loaded through GLFW so no extension loader is needed
+
+typedef void (APIENTRY *GenBuffersProc)(GLsizei, GLuint*);
+typedef void (APIENTRY *DeleteBuffersProc)(GLsizei, const GLuint*);
+typedef void (APIENTRY *BindBufferProc)(GLenum, GLuint);
+typedef void (APIENTRY *BufferDataProc)(GLenum, ptrdiff_t, const void*, GLenum);
+typedef void (APIENTRY *GenVertexArraysProc)(GLsizei, GLuint*);
+typedef void (APIENTRY *DeleteVertexArraysProc)(GLsizei, const GLuint*);
+typedef void (APIENTRY *BindVertexArrayProc)(GLuint);
+typedef void (APIENTRY *VertexAttribPointerProc)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+typedef void (APIENTRY *EnableVertexAttribArrayProc)(GLuint);
+typedef GLuint (APIENTRY *CreateShaderProc)(GLenum);
+typedef void (APIENTRY *ShaderSourceProc)(GLuint, GLsizei, const char* const*, const GLint*);
+typedef void (APIENTRY *CompileShaderProc)(GLuint);
+typedef void (APIENTRY *GetShaderivProc)(GLuint, GLenum, GLint*);
+typedef void (APIENTRY *GetShaderInfoLogProc)(GLuint, GLsizei, GLsizei*, char*);
+typedef void (APIENTRY *DeleteShaderProc)(GLuint);
+typedef GLuint (APIENTRY *CreateProgramProc)(void);
+typedef void (APIENTRY *AttachShaderProc)(GLuint, GLuint);
+typedef void (APIENTRY *LinkProgramProc)(GLuint);
+typedef void (APIENTRY *GetProgramivProc)(GLuint, GLenum, GLint*);
+typedef void (APIENTRY *GetProgramInfoLogProc)(GLuint, GLsizei, GLsizei*, char*);
+typedef void (APIENTRY *DeleteProgramProc)(GLuint);
+typedef void (APIENTRY *UseProgramProc)(GLuint);
+typedef GLint (APIENTRY *GetUniformLocationProc)(GLuint, const char*);
+typedef void (APIENTRY *UniformMatrix4fvProc)(GLint, GLsizei, GLboolean, const float*);
+typedef void (APIENTRY *UniformMatrix3fvProc)(GLint, GLsizei, GLboolean, const float*);
+typedef void (APIENTRY *Uniform1iProc)(GLint, GLint);
+typedef void (APIENTRY *Uniform3fvProc)(GLint, GLsizei, const float*);
+typedef void (APIENTRY *Uniform4fvProc)(GLint, GLsizei, const float*);
+typedef void (APIENTRY *DrawArraysInstancedProc)(GLenum, GLint, GLsizei, GLsizei);
+typedef void (APIENTRY *VertexAttribDivisorProc)(GLuint, GLuint);
+
+static GenBuffersProc pGenBuffers;
+static DeleteBuffersProc pDeleteBuffers;
+static BindBufferProc pBindBuffer;
+static BufferDataProc pBufferData;
+static GenVertexArraysProc pGenVertexArrays;
+static DeleteVertexArraysProc pDeleteVertexArrays;
+static BindVertexArrayProc pBindVertexArray;
+static VertexAttribPointerProc pVertexAttribPointer;
+static EnableVertexAttribArrayProc pEnableVertexAttribArray;
+static CreateShaderProc pCreateShader;
+static ShaderSourceProc pShaderSource;
+static CompileShaderProc pCompileShader;
+static GetShaderivProc pGetShaderiv;
+static GetShaderInfoLogProc pGetShaderInfoLog;
+static DeleteShaderProc pDeleteShader;
+static CreateProgramProc pCreateProgram;
+static AttachShaderProc pAttachShader;
+static LinkProgramProc pLinkProgram;
+static GetProgramivProc pGetProgramiv;
+static GetProgramInfoLogProc pGetProgramInfoLog;
+static DeleteProgramProc pDeleteProgram;
+static UseProgramProc pUseProgram;
+static GetUniformLocationProc pGetUniformLocation;
+static UniformMatrix4fvProc pUniformMatrix4fv;
+static UniformMatrix3fvProc pUniformMatrix3fv;
+static Uniform1iProc pUniform1i;
+static Uniform3fvProc pUniform3fv;
+static Uniform4fvProc pUniform4fv;
+static DrawArraysInstancedProc pDrawArraysInstanced;
+static VertexAttribDivisorProc pVertexAttribDivisor;
+
+template <typename T>
+static bool loadProc(T& proc, const char* name) {
+    proc = reinterpret_cast<T>(glfwGetProcAddress(name));
+    if (!proc) {
+        std::cerr << "Missing OpenGL function: " << name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool loadCoreProcs() {
+    bool ok = true;
+    ok &= loadProc(pGenBuffers, "glGenBuffers");
+    ok &= loadProc(pDeleteBuffers, "glDeleteBuffers");
+    ok &= loadProc(pBindBuffer, "glBindBuffer");
+    ok &= loadProc(pBufferData, "glBufferData");
+    ok &= loadProc(pGenVertexArrays, "glGenVertexArrays");
+    ok &= loadProc(pDeleteVertexArrays, "glDeleteVertexArrays");
+    ok &= loadProc(pBindVertexArray, "glBindVertexArray");
+    ok &= loadProc(pVertexAttribPointer, "glVertexAttribPointer");
+    ok &= loadProc(pEnableVertexAttribArray, "glEnableVertexAttribArray");
+    ok &= loadProc(pCreateShader, "glCreateShader");
+    ok &= loadProc(pShaderSource, "glShaderSource");
+    ok &= loadProc(pCompileShader, "glCompileShader");
+    ok &= loadProc(pGetShaderiv, "glGetShaderiv");
+    ok &= loadProc(pGetShaderInfoLog, "glGetShaderInfoLog");
+    ok &= loadProc(pDeleteShader, "glDeleteShader");
+    ok &= loadProc(pCreateProgram, "glCreateProgram");
+    ok &= loadProc(pAttachShader, "glAttachShader");
+    ok &= loadProc(pLinkProgram, "glLinkProgram");
+    ok &= loadProc(pGetProgramiv, "glGetProgramiv");
+    ok &= loadProc(pGetProgramInfoLog, "glGetProgramInfoLog");
+    ok &= loadProc(pDeleteProgram, "glDeleteProgram");
+    ok &= loadProc(pUseProgram, "glUseProgram");
+    ok &= loadProc(pGetUniformLocation, "glGetUniformLocation");
+    ok &= loadProc(pUniformMatrix4fv, "glUniformMatrix4fv");
+    ok &= loadProc(pUniformMatrix3fv, "glUniformMatrix3fv");
+    ok &= loadProc(pUniform1i, "glUniform1i");
+    ok &= loadProc(pUniform3fv, "glUniform3fv");
+    ok &= loadProc(pUniform4fv, "glUniform4fv");
+    ok &= loadProc(pDrawArraysInstanced, "glDrawArraysInstanced");
+    ok &= loadProc(pVertexAttribDivisor, "glVertexAttribDivisor");
+    return ok;
+}
+
+// ============ SHADERS ============
+
+// Per-vertex lighting matching the fixed-function setup the game uses:
+// one directional light, color material for ambient and diffuse,
+// and the default global ambient of 0.2.
+// aOffset is the per-instance translation of instanced meshes; other draws
+// leave the attribute disabled, so it reads as zero.
+static const char* VERTEX_SHADER =
+    "#version 330 core\n"
+    "layout(location = 0) in vec3 aPos;\n"
+    "layout(location = 1) in vec4 aColor;\n"
+    "layout(location = 2) in vec3 aNormal;\n"
+    "layout(location = 3) in vec2 aTexCoord;\n"
+    "layout(location = 4) in vec3 aOffset;\n"
+    "uniform mat4 uMvp;\n"
+    "uniform mat3 uNormalMatrix;\n"
+    "uniform bool uLighting;\n"
+    "uniform bool uUseColor;\n"
+    "uniform vec4 uColor;\n"
+    "uniform vec3 uLightDir;\n"
+    "uniform vec4 uLightAmbient;\n"
+    "uniform vec4 uLightDiffuse;\n"
+    "out vec4 vColor;\n"
+    "out vec2 vTexCoord;\n"
+    "void main() {\n"
+    "    vec4 color = uUseColor ? uColor : aColor;\n"
+    "    if (uLighting) {\n"
+    "        vec3 n = normalize(uNormalMatrix * aNormal);\n"
+    "        float diffuse = max(dot(n, uLightDir), 0.0);\n"
+    "        vec3 light = vec3(0.2) + uLightAmbient.rgb + uLightDiffuse.rgb * diffuse;\n"
+    "        color = vec4(clamp(color.rgb * light, 0.0, 1.0), color.a);\n"
+    "    }\n"
+    "    vColor = color;\n"
+    "    vTexCoord = aTexCoord;\n"
+    "    gl_Position = uMvp * vec4(aPos + aOffset, 1.0);\n"
+    "}\n";
+
+// Textures are single-channel coverage (the font atlas), like GL_ALPHA with GL_MODULATE
+static const char* FRAGMENT_SHADER =
+    "#version 330 core\n"
+    "in vec4 vColor;\n"
+    "in vec2 vTexCoord;\n"
+    "uniform bool uTextured;\n"
+    "uniform sampler2D uTexture;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    vec4 color = vColor;\n"
+    "    if (uTextured) color.a *= texture(uTexture, vTexCoord).r;\n"
+    "    fragColor = color;\n"
+    "}\n";
+
+// ============ STATE ============
+
+struct Vertex {
+    float pos[3];
+    float color[4];
+    float normal[3];
+    float uv[2];
+};
+
+struct Mat4 {
+    float m[16];  // Column-major, like OpenGL
+};
+
+struct DrawCommand {
+    GLenum mode;
+    GLint first;
+    GLsizei count;
+    bool useCurrentColor;   // No color was set in the list before this geometry
+};
+
+struct ListData {
+    GLuint vao;
+    GLuint vbo;
+    std::vector<DrawCommand> commands;
+    bool setsColor;         // The list leaves this color current after it runs
+    float color[4];
+
+    ListData() : vao(0), vbo(0), setsColor(false) {
+        color[0] = color[1] = color[2] = color[3] = 1.0f;
+    }
+};
+
+struct MeshData {
+    std::vector<Vertex> vertices;   // Triangles, then lines (kept for LEGACY batches)
+    GLsizei triangleCount;
+    GLsizei lineCount;
+    float color[4];                 // Last color set while recording
+    GLuint vao;
+    GLuint vbo;
+    GLuint instanceVbo;             // Per-instance offsets, refilled on every draw
+
+    MeshData() : triangleCount(0), lineCount(0), vao(0), vbo(0), instanceVbo(0) {
+        color[0] = color[1] = color[2] = color[3] = 1.0f;
+    }
+};
+
+static Backend backend = Backend::LEGACY;
+static bool coreReady = false;
+
+// Current vertex attributes
+static float currentColor[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+static float currentNormal[3] = {0.0f, 0.0f, 1.0f};
+
+// Primitive being built between begin() and end()
+static GLenum batchMode = GL_TRIANGLES;
+static std::vector<Vertex> batch;
+static std::vector<Vertex> converted;
+
+// Matrix stacks
+static std::vector<Mat4> modelviewStack;
+static std::vector<Mat4> projectionStack;
+static GLenum currentMatrixMode = GL_MODELVIEW;
+
+// Emulated fixed-function state
+static bool lightingEnabled = false;
+static bool texturingEnabled = false;
+static float lightDir[3] = {0.0f, 0.0f, 1.0f};     // Eye space
+static float lightAmbient[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+static float lightDiffuse[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+// Display lists (index = list ID, 0 is unused)
+static std::vector<ListData> lists(1);
+static GLuint recordingList = 0;
+static std::vector<Vertex> recordVertices;
+static bool recordColorSet = false;
+static float savedColor[4];
+static float savedNormal[3];
+
+// Instanced meshes (index = mesh ID, 0 is unused)
+static std::vector<MeshData> meshes(1);
+static GLuint recordingMesh = 0;
+static std::vector<Vertex> meshTriangles;
+static std::vector<Vertex> meshLines;
+static std::vector<Vertex> instanceBatch;   // LEGACY: all instances expanded
+
+// GPU objects
+static GLuint program = 0;
+static GLuint streamVao = 0;
+static GLuint streamVbo = 0;
+static GLint uMvp, uNormalMatrix, uLighting, uUseColor, uColor;
+static GLint uLightDir, uLightAmbient, uLightDiffuse, uTextured, uTexture;
+
+// ============ MATRIX MATH ============
+
+static Mat4 identity() {
+    Mat4 r;
+    for (int i = 0; i < 16; i++) r.m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    return r;
+}
+
+static Mat4 multiply(const Mat4& a, const Mat4& b) {
+    Mat4 r;
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) {
+                sum += a.m[k * 4 + row] * b.m[col * 4 + k];
+            }
+            r.m[col * 4 + row] = sum;
+        }
+    }
+    return r;
+}
+
+static Mat4& currentMatrix() {
+    return currentMatrixMode == GL_PROJECTION ? projectionStack.back() : modelviewStack.back();
+}
+
+static void multCurrent(const Mat4& m) {
+    Mat4& top = currentMatrix();
+    top = multiply(top, m);
+}
+
+// Inverse transpose of the upper 3x3 (cofactors over the determinant)
+static void normalMatrix(const Mat4& mv, float out[9]) {
+    const float* m = mv.m;
+    float a = m[0], b = m[4], c = m[8];
+    float d = m[1], e = m[5], f = m[9];
+    float g = m[2], h = m[6], i = m[10];
+
+    float c00 = e * i - f * h, c01 = -(d * i - f * g), c02 = d * h - e * g;
+    float c10 = -(b * i - c * h), c11 = a * i - c * g, c12 = -(a * h - b * g);
+    float c20 = b * f - c * e, c21 = -(a * f - c * d), c22 = a * e - b * d;
+
+    float det = a * c00 + b * c01 + c * c02;
+    float inv = (std::fabs(det) > 1e-12f) ? 1.0f / det : 1.0f;
+
+    // Column-major mat3: column j holds cofactors of column j
+    out[0] = c00 * inv; out[1] = c10 * inv; out[2] = c20 * inv;
+    out[3] = c01 * inv; out[4] = c11 * inv; out[5] = c21 * inv;
+    out[6] = c02 * inv; out[7] = c12 * inv; out[8] = c22 * inv;
+}
+
+// ============ CORE HELPERS ============
+
+static GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = pCreateShader(type);
+    pShaderSource(shader, 1, &source, nullptr);
+    pCompileShader(shader);
+
+    GLint ok = 0;
+    pGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        pGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cerr << "Shader compile error: " << log << std::endl;
+        pDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+static void setupVertexLayout() {
+    const GLsizei stride = sizeof(Vertex);
+    pEnableVertexAttribArray(0);
+    pVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (const void*)offsetof(Vertex, pos));
+    pEnableVertexAttribArray(1);
+    pVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (const void*)offsetof(Vertex, color));
+    pEnableVertexAttribArray(2);
+    pVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (const void*)offsetof(Vertex, normal));
+    pEnableVertexAttribArray(3);
+    pVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride, (const void*)offsetof(Vertex, uv));
+}
+
+static bool initCore() {
+    if (!loadCoreProcs()) return false;
+
+    GLuint vs = compileShader(GL_VERTEX_SHADER, VERTEX_SHADER);
+    GLuint fs = compileShader(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+    if (vs == 0 || fs == 0) return false;
+
+    program = pCreateProgram();
+    pAttachShader(program, vs);
+    pAttachShader(program, fs);
+    pLinkProgram(program);
+    pDeleteShader(vs);
+    pDeleteShader(fs);
+
+    GLint ok = 0;
+    pGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        pGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        std::cerr << "Shader link error: " << log << std::endl;
+        return false;
+    }
+
+    uMvp = pGetUniformLocation(program, "uMvp");
+    uNormalMatrix = pGetUniformLocation(program, "uNormalMatrix");
+    uLighting = pGetUniformLocation(program, "uLighting");
+    uUseColor = pGetUniformLocation(program, "uUseColor");
+    uColor = pGetUniformLocation(program, "uColor");
+    uLightDir = pGetUniformLocation(program, "uLightDir");
+    uLightAmbient = pGetUniformLocation(program, "uLightAmbient");
+    uLightDiffuse = pGetUniformLocation(program, "uLightDiffuse");
+    uTextured = pGetUniformLocation(program, "uTextured");
+    uTexture = pGetUniformLocation(program, "uTexture");
+
+    pUseProgram(program);
+    pUniform1i(uTexture, 0);
+
+    // Vertex array for immediate-mode batches, refilled on every draw
+    pGenVertexArrays(1, &streamVao);
+    pGenBuffers(1, &streamVbo);
+    pBindVertexArray(streamVao);
+    pBindBuffer(GL_ARRAY_BUFFER, streamVbo);
+    setupVertexLayout();
+
+    return true;
+}
+
+// Upload everything the shader needs for the next draw
+static void applyUniforms(bool useCurrentColor) {
+    const Mat4& mv = modelviewStack.back();
+    Mat4 mvp = multiply(projectionStack.back(), mv);
+    float nm[9];
+    normalMatrix(mv, nm);
+
+    pUniformMatrix4fv(uMvp, 1, GL_FALSE, mvp.m);
+    pUniformMatrix3fv(uNormalMatrix, 1, GL_FALSE, nm);
+    pUniform1i(uLighting, lightingEnabled ? 1 : 0);
+    pUniform1i(uTextured, texturingEnabled ? 1 : 0);
+    pUniform1i(uUseColor, useCurrentColor ? 1 : 0);
+    pUniform4fv(uColor, 1, currentColor);
+    pUniform3fv(uLightDir, 1, lightDir);
+    pUniform4fv(uLightAmbient, 1, lightAmbient);
+    pUniform4fv(uLightDiffuse, 1, lightDiffuse);
+}
+
+// Rewrite primitives the core profile dropped; returns the mode to draw with
+static GLenum convertPrimitive(GLenum mode, const std::vector<Vertex>& in, std::vector<Vertex>& out) {
+    out.clear();
+    if (mode == GL_QUADS) {
+        for (size_t q = 0; q + 3 < in.size(); q += 4) {
+            out.push_back(in[q]); out.push_back(in[q + 1]); out.push_back(in[q + 2]);
+            out.push_back(in[q]); out.push_back(in[q + 2]); out.push_back(in[q + 3]);
+        }
+        return GL_TRIANGLES;
+    }
+    if (mode == GL_QUAD_STRIP) {
+        for (size_t q = 0; q + 3 < in.size(); q += 2) {
+            out.push_back(in[q]); out.push_back(in[q + 1]); out.push_back(in[q + 3]);
+            out.push_back(in[q]); out.push_back(in[q + 3]); out.push_back(in[q + 2]);
+        }
+        return GL_TRIANGLES;
+    }
+    out = in;
+    if (mode == GL_POLYGON) return GL_TRIANGLE_FAN;
+    return mode;
+}
+
+static void drawStream(GLenum mode, const std::vector<Vertex>& vertices) {
+    if (vertices.empty()) return;
+
+    applyUniforms(false);
+    pBindVertexArray(streamVao);
+    pBindBuffer(GL_ARRAY_BUFFER, streamVbo);
+    pBufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(vertices.size() * sizeof(Vertex)),
+                vertices.data(), GL_STREAM_DRAW);
+    glDrawArrays(mode, 0, (GLsizei)vertices.size());
+}
+
+// LEGACY calls go straight to OpenGL, except while a mesh is recorded
+static bool forwardToGL() {
+    return backend == Backend::LEGACY && recordingMesh == 0;
+}
+
+static void emitVertex(float x, float y, float z) {
+    Vertex v;
+    v.pos[0] = x; v.pos[1] = y; v.pos[2] = z;
+    memcpy(v.color, currentColor, sizeof(v.color));
+    memcpy(v.normal, currentNormal, sizeof(v.normal));
+    v.uv[0] = v.uv[1] = 0.0f;
+    batch.push_back(v);
+}
+
+// ============ PUBLIC API ============
+
+bool init(Backend requested) {
+    backend = requested;
+    modelviewStack.assign(1, identity());
+    projectionStack.assign(1, identity());
+
+    if (backend == Backend::CORE) {
+        coreReady = initCore();
+        if (!coreReady) {
+            std::cerr << "Failed to initialize the OpenGL 3.3 core renderer" << std::endl;
+            return false;
+        }
+    }
+
+    const GLubyte* version = glGetString(GL_VERSION);
+    std::cout << "Renderer: " << getBackendName() << " (OpenGL "
+              << (version ? (const char*)version : "unknown") << ")" << std::endl;
+    return true;
+}
+
+void cleanup() {
+    if (backend != Backend::CORE || !coreReady) return;
+
+    for (size_t i = 1; i < lists.size(); i++) {
+        if (lists[i].vbo) pDeleteBuffers(1, &lists[i].vbo);
+        if (lists[i].vao) pDeleteVertexArrays(1, &lists[i].vao);
+    }
+    lists.assign(1, ListData());
+
+    for (size_t i = 1; i < meshes.size(); i++) {
+        deleteMesh((GLuint)i);
+    }
+
+    pDeleteBuffers(1, &streamVbo);
+    pDeleteVertexArrays(1, &streamVao);
+    pDeleteProgram(program);
+    streamVbo = streamVao = program = 0;
+    coreReady = false;
+}
+
+Backend getBackend() {
+    return backend;
+}
+
+const char* getBackendName() {
+    return backend == Backend::CORE ? "core" : "legacy";
+}
+
+void begin(GLenum mode) {
+    if (forwardToGL()) { glBegin(mode); return; }
+    batchMode = mode;
+    batch.clear();
+}
+
+void end() {
+    if (forwardToGL()) { glEnd(); return; }
+
+    GLenum mode = convertPrimitive(batchMode, batch, converted);
+    if (converted.empty()) return;
+
+    if (recordingMesh != 0) {
+        if (mode == GL_TRIANGLES) {
+            meshTriangles.insert(meshTriangles.end(), converted.begin(), converted.end());
+        } else if (mode == GL_LINES) {
+            meshLines.insert(meshLines.end(), converted.begin(), converted.end());
+        }
+        return;
+    }
+
+    if (recordingList != 0) {
+        // Append to the list, merging with the previous batch when possible
+        std::vector<DrawCommand>& commands = lists[recordingList].commands;
+        bool mergeable = (mode == GL_TRIANGLES || mode == GL_LINES);
+        if (mergeable && !commands.empty() && commands.back().mode == mode &&
+            commands.back().useCurrentColor == !recordColorSet) {
+            commands.back().count += (GLsizei)converted.size();
+        } else {
+            DrawCommand cmd;
+            cmd.mode = mode;
+            cmd.first = (GLint)recordVertices.size();
+            cmd.count = (GLsizei)converted.size();
+            cmd.useCurrentColor = !recordColorSet;
+            commands.push_back(cmd);
+        }
+        recordVertices.insert(recordVertices.end(), converted.begin(), converted.end());
+        return;
+    }
+
+    drawStream(mode, converted);
+}
+
+void vertex2f(float x, float y) {
+    if (forwardToGL()) { glVertex2f(x, y); return; }
+    emitVertex(x, y, 0.0f);
+}
+
+void vertex3f(float x, float y, float z) {
+    if (forwardToGL()) { glVertex3f(x, y, z); return; }
+    emitVertex(x, y, z);
+}
+
+void color3f(float r, float g, float b) {
+    if (forwardToGL()) { glColor3f(r, g, b); return; }
+    color4f(r, g, b, 1.0f);
+}
+
+void color4f(float r, float g, float b, float a) {
+    if (forwardToGL()) { glColor4f(r, g, b, a); return; }
+    currentColor[0] = r; currentColor[1] = g; currentColor[2] = b; currentColor[3] = a;
+    if (recordingList != 0) recordColorSet = true;
+}
+
+void normal3f(float x, float y, float z) {
+    if (forwardToGL()) { glNormal3f(x, y, z); return; }
+    currentNormal[0] = x; currentNormal[1] = y; currentNormal[2] = z;
+}
+
+void matrixMode(GLenum mode) {
+    if (backend == Backend::LEGACY) { glMatrixMode(mode); return; }
+    currentMatrixMode = mode;
+}
+
+void loadIdentity() {
+    if (backend == Backend::LEGACY) { glLoadIdentity(); return; }
+    currentMatrix() = identity();
+}
+
+void pushMatrix() {
+    if (backend == Backend::LEGACY) { glPushMatrix(); return; }
+    std::vector<Mat4>& stack = (currentMatrixMode == GL_PROJECTION) ? projectionStack : modelviewStack;
+    stack.push_back(stack.back());
+}
+
+void popMatrix() {
+    if (backend == Backend::LEGACY) { glPopMatrix(); return; }
+    std::vector<Mat4>& stack = (currentMatrixMode == GL_PROJECTION) ? projectionStack : modelviewStack;
+    if (stack.size() > 1) stack.pop_back();
+}
+
+void translatef(float x, float y, float z) {
+    if (backend == Backend::LEGACY) { glTranslatef(x, y, z); return; }
+    Mat4 t = identity();
+    t.m[12] = x; t.m[13] = y; t.m[14] = z;
+    multCurrent(t);
+}
+
+void rotatef(float angle, float x, float y, float z) {
+    if (backend == Backend::LEGACY) { glRotatef(angle, x, y, z); return; }
+    float len = std::sqrt(x * x + y * y + z * z);
+    if (len == 0.0f) return;
+    x /= len; y /= len; z /= len;
+
+    float rad = angle * (float)M_PI / 180.0f;
+    float c = std::cos(rad);
+    float s = std::sin(rad);
+    float k = 1.0f - c;
+
+    Mat4 r = identity();
+    r.m[0] = x * x * k + c;     r.m[4] = x * y * k - z * s; r.m[8] = x * z * k + y * s;
+    r.m[1] = y * x * k + z * s; r.m[5] = y * y * k + c;     r.m[9] = y * z * k - x * s;
+    r.m[2] = x * z * k - y * s; r.m[6] = y * z * k + x * s; r.m[10] = z * z * k + c;
+    multCurrent(r);
+}
+
+void scalef(float x, float y, float z) {
+    if (backend == Backend::LEGACY) { glScalef(x, y, z); return; }
+    Mat4 t = identity();
+    t.m[0] = x; t.m[5] = y; t.m[10] = z;
+    multCurrent(t);
+}
+
+void multMatrixf(const float* m) {
+    if (backend == Backend::LEGACY) { glMultMatrixf(m); return; }
+    Mat4 t;
+    memcpy(t.m, m, sizeof(t.m));
+    multCurrent(t);
+}
+
+void ortho(double left, double right, double bottom, double top, double zNear, double zFar) {
+    if (backend == Backend::LEGACY) { glOrtho(left, right, bottom, top, zNear, zFar); return; }
+    Mat4 o = identity();
+    o.m[0] = (float)(2.0 / (right - left));
+    o.m[5] = (float)(2.0 / (top - bottom));
+    o.m[10] = (float)(-2.0 / (zFar - zNear));
+    o.m[12] = (float)(-(right + left) / (right - left));
+    o.m[13] = (float)(-(top + bottom) / (top - bottom));
+    o.m[14] = (float)(-(zFar + zNear) / (zFar - zNear));
+    multCurrent(o);
+}
+
+void enable(GLenum cap) {
+    if (backend == Backend::LEGACY) { glEnable(cap); return; }
+    switch (cap) {
+        case GL_LIGHTING: lightingEnabled = true; break;
+        case GL_TEXTURE_2D: texturingEnabled = true; break;
+        case GL_LIGHT0:
+        case GL_COLOR_MATERIAL:
+        case GL_NORMALIZE:
+            break;  // Always on in the shader
+        default: glEnable(cap); break;
+    }
+}
+
+void disable(GLenum cap) {
+    if (backend == Backend::LEGACY) { glDisable(cap); return; }
+    switch (cap) {
+        case GL_LIGHTING: lightingEnabled = false; break;
+        case GL_TEXTURE_2D: texturingEnabled = false; break;
+        case GL_LIGHT0:
+        case GL_COLOR_MATERIAL:
+        case GL_NORMALIZE:
+            break;
+        default: glDisable(cap); break;
+    }
+}
+
+void lineWidth(float width) {
+#ifdef __APPLE__
+    // Forward-compatible contexts reject wide lines
+    if (backend == Backend::CORE && width > 1.0f) width = 1.0f;
+#endif
+    glLineWidth(width);
+}
+
+void shadeModel(GLenum mode) {
+    if (backend == Backend::LEGACY) { glShadeModel(mode); return; }
+    // Vertex colors are always interpolated in the core shader
+}
+
+void colorMaterial(GLenum face, GLenum mode) {
+    if (backend == Backend::LEGACY) { glColorMaterial(face, mode); return; }
+    // The core shader always uses the vertex color for ambient and diffuse
+}
+
+void lightfv(GLenum light, GLenum pname, const float* params) {
+    if (backend == Backend::LEGACY) { glLightfv(light, pname, params); return; }
+    if (light != GL_LIGHT0) return;
+
+    if (pname == GL_POSITION) {
+        // Like fixed function, the position is stored in eye space
+        const float* m = modelviewStack.back().m;
+        float x = m[0] * params[0] + m[4] * params[1] + m[8] * params[2];
+        float y = m[1] * params[0] + m[5] * params[1] + m[9] * params[2];
+        float z = m[2] * params[0] + m[6] * params[1] + m[10] * params[2];
+        float len = std::sqrt(x * x + y * y + z * z);
+        if (len > 0.0f) {
+            lightDir[0] = x / len; lightDir[1] = y / len; lightDir[2] = z / len;
+        }
+    } else if (pname == GL_AMBIENT) {
+        memcpy(lightAmbient, params, sizeof(lightAmbient));
+    } else if (pname == GL_DIFFUSE) {
+        memcpy(lightDiffuse, params, sizeof(lightDiffuse));
+    }
+}
+
+GLuint genLists(GLsizei range) {
+    if (backend == Backend::LEGACY) return glGenLists(range);
+    if (range <= 0) return 0;
+
+    GLuint base = (GLuint)lists.size();
+    lists.resize(lists.size() + range);
+    return base;
+}
+
+void newList(GLuint list, GLenum mode) {
+    if (backend == Backend::LEGACY) { glNewList(list, mode); return; }
+    if (list == 0 || list >= lists.size()) return;
+
+    // Recording must not change the current state
+    memcpy(savedColor, currentColor, sizeof(savedColor));
+    memcpy(savedNormal, currentNormal, sizeof(savedNormal));
+
+    recordingList = list;
+    recordVertices.clear();
+    recordColorSet = false;
+    lists[list].commands.clear();
+}
+
+void endList() {
+    if (backend == Backend::LEGACY) { glEndList(); return; }
+    if (recordingList == 0) return;
+
+    ListData& data = lists[recordingList];
+    data.setsColor = recordColorSet;
+    memcpy(data.color, currentColor, sizeof(data.color));
+
+    if (data.vao == 0) {
+        pGenVertexArrays(1, &data.vao);
+        pGenBuffers(1, &data.vbo);
+        pBindVertexArray(data.vao);
+        pBindBuffer(GL_ARRAY_BUFFER, data.vbo);
+        setupVertexLayout();
+    } else {
+        pBindVertexArray(data.vao);
+        pBindBuffer(GL_ARRAY_BUFFER, data.vbo);
+    }
+    pBufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(recordVertices.size() * sizeof(Vertex)),
+                recordVertices.empty() ? nullptr : recordVertices.data(), GL_STATIC_DRAW);
+
+    memcpy(currentColor, savedColor, sizeof(currentColor));
+    memcpy(currentNormal, savedNormal, sizeof(currentNormal));
+    recordingList = 0;
+    recordVertices.clear();
+}
+
+void callList(GLuint list) {
+    if (backend == Backend::LEGACY) { glCallList(list); return; }
+    if (list == 0 || list >= lists.size()) return;
+
+    const ListData& data = lists[list];
+    if (!data.commands.empty()) {
+        pBindVertexArray(data.vao);
+        bool uniformsForCurrentColor = false;
+        applyUniforms(false);
+        for (const DrawCommand& cmd : data.commands) {
+            if (cmd.useCurrentColor != uniformsForCurrentColor) {
+                pUniform1i(uUseColor, cmd.useCurrentColor ? 1 : 0);
+                uniformsForCurrentColor = cmd.useCurrentColor;
+            }
+            glDrawArrays(cmd.mode, cmd.first, cmd.count);
+        }
+    }
+
+    if (data.setsColor) {
+        memcpy(currentColor, data.color, sizeof(currentColor));
+    }
+}
+
+void callLists(GLuint base, GLsizei count, const GLuint* offsets) {
+    if (backend == Backend::LEGACY) {
+        glListBase(base);
+        glCallLists(count, GL_UNSIGNED_INT, offsets);
+        glListBase(0);
+        return;
+    }
+    for (GLsizei i = 0; i < count; i++) {
+        callList(base + offsets[i]);
+    }
+}
+
+void deleteLists(GLuint list, GLsizei range) {
+    if (backend == Backend::LEGACY) { glDeleteLists(list, range); return; }
+    if (!coreReady) return;
+
+    for (GLsizei i = 0; i < range; i++) {
+        GLuint id = list + (GLuint)i;
+        if (id == 0 || id >= lists.size()) continue;
+        if (lists[id].vbo) pDeleteBuffers(1, &lists[id].vbo);
+        if (lists[id].vao) pDeleteVertexArrays(1, &lists[id].vao);
+        lists[id] = ListData();
+    }
+}
+
+GLuint beginMesh() {
+    // Recording must not change the current state
+    memcpy(savedColor, currentColor, sizeof(savedColor));
+    memcpy(savedNormal, currentNormal, sizeof(savedNormal));
+    currentColor[0] = currentColor[1] = currentColor[2] = currentColor[3] = 1.0f;
+    currentNormal[0] = 0.0f; currentNormal[1] = 0.0f; currentNormal[2] = 1.0f;
+
+    meshes.push_back(MeshData());
+    recordingMesh = (GLuint)(meshes.size() - 1);
+    meshTriangles.clear();
+    meshLines.clear();
+    return recordingMesh;
+}
+
+void endMesh() {
+    if (recordingMesh == 0) return;
+
+    MeshData& mesh = meshes[recordingMesh];
+    mesh.vertices = meshTriangles;
+    mesh.vertices.insert(mesh.vertices.end(), meshLines.begin(), meshLines.end());
+    mesh.triangleCount = (GLsizei)meshTriangles.size();
+    mesh.lineCount = (GLsizei)meshLines.size();
+    memcpy(mesh.color, currentColor, sizeof(mesh.color));
+
+    if (backend == Backend::CORE && coreReady && !mesh.vertices.empty()) {
+        pGenVertexArrays(1, &mesh.vao);
+        pGenBuffers(1, &mesh.vbo);
+        pGenBuffers(1, &mesh.instanceVbo);
+        pBindVertexArray(mesh.vao);
+        pBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+        pBufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(mesh.vertices.size() * sizeof(Vertex)),
+                    mesh.vertices.data(), GL_STATIC_DRAW);
+        setupVertexLayout();
+
+        // One offset per instance rather than per vertex
+        pBindBuffer(GL_ARRAY_BUFFER, mesh.instanceVbo);
+        pEnableVertexAttribArray(4);
+        pVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (const void*)0);
+        pVertexAttribDivisor(4, 1);
+
+        // The GPU has the geometry; only LEGACY needs the CPU copy
+        mesh.vertices.clear();
+        mesh.vertices.shrink_to_fit();
+    }
+
+    memcpy(currentColor, savedColor, sizeof(currentColor));
+    memcpy(currentNormal, savedNormal, sizeof(currentNormal));
+    recordingMesh = 0;
+    meshTriangles.clear();
+    meshLines.clear();
+}
+
+void drawMeshInstanced(GLuint id, const float* offsets, int count) {
+    if (id == 0 || id >= meshes.size() || count <= 0) return;
+    const MeshData& mesh = meshes[id];
+
+    if (backend == Backend::CORE) {
+        if (mesh.vao == 0) return;
+        applyUniforms(false);
+        pBindVertexArray(mesh.vao);
+        pBindBuffer(GL_ARRAY_BUFFER, mesh.instanceVbo);
+        pBufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(count * 3 * sizeof(float)), offsets, GL_STREAM_DRAW);
+        if (mesh.triangleCount > 0) {
+            pDrawArraysInstanced(GL_TRIANGLES, 0, mesh.triangleCount, count);
+        }
+        if (mesh.lineCount > 0) {
+            pDrawArraysInstanced(GL_LINES, mesh.triangleCount, mesh.lineCount, count);
+        }
+        memcpy(currentColor, mesh.color, sizeof(currentColor));
+        return;
+    }
+
+    // All instances' triangles, then all their lines, each in one draw
+    size_t perInstance = mesh.vertices.size();
+    if (perInstance == 0) return;
+    instanceBatch.resize(perInstance * (size_t)count);
+    size_t out = 0;
+    for (int part = 0; part < 2; part++) {
+        size_t first = (part == 0) ? 0 : (size_t)mesh.triangleCount;
+        size_t last = (part == 0) ? (size_t)mesh.triangleCount : perInstance;
+        for (int i = 0; i < count; i++) {
+            const float* offset = offsets + i * 3;
+            for (size_t v = first; v < last; v++) {
+                Vertex vertex = mesh.vertices[v];
+                vertex.pos[0] += offset[0];
+                vertex.pos[1] += offset[1];
+                vertex.pos[2] += offset[2];
+                instanceBatch[out++] = vertex;
+            }
+        }
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(Vertex), instanceBatch[0].pos);
+    glColorPointer(4, GL_FLOAT, sizeof(Vertex), instanceBatch[0].color);
+    glNormalPointer(GL_FLOAT, sizeof(Vertex), instanceBatch[0].normal);
+    GLsizei triangles = mesh.triangleCount * count;
+    GLsizei lines = mesh.lineCount * count;
+    if (triangles > 0) glDrawArrays(GL_TRIANGLES, 0, triangles);
+    if (lines > 0) glDrawArrays(GL_LINES, triangles, lines);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    // The current color is undefined after a color array; leave the mesh's
+    glColor4fv(mesh.color);
+}
+
+void deleteMesh(GLuint id) {
+    if (id == 0 || id >= meshes.size()) return;
+    MeshData& mesh = meshes[id];
+    if (backend == Backend::CORE && coreReady) {
+        if (mesh.instanceVbo) pDeleteBuffers(1, &mesh.instanceVbo);
+        if (mesh.vbo) pDeleteBuffers(1, &mesh.vbo);
+        if (mesh.vao) pDeleteVertexArrays(1, &mesh.vao);
+    }
+    mesh = MeshData();
+}
+
+void drawTexturedQuads2D(const float* xyuv, int vertexCount) {
+    if (vertexCount <= 0) return;
+
+    if (backend == Backend::LEGACY) {
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glVertexPointer(2, GL_FLOAT, 4 * sizeof(float), xyuv);
+        glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(float), xyuv + 2);
+        glDrawArrays(GL_QUADS, 0, vertexCount);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        return;
+    }
+
+    batch.clear();
+    for (int i = 0; i < vertexCount; i++) {
+        const float* v = xyuv + i * 4;
+        emitVertex(v[0], v[1], 0.0f);
+        batch.back().uv[0] = v[2];
+        batch.back().uv[1] = v[3];
+    }
+    GLenum mode = convertPrimitive(GL_QUADS, batch, converted);
+    drawStream(mode, converted);
+}
+
+void texImageAlpha(int width, int height, const void* pixels) {
+    if (backend == Backend::LEGACY) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+        return;
+    }
+    // GL_ALPHA is gone in core; the shader reads coverage from the red channel
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+}
+
+} // namespace Gfx
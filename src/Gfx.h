@@ -0,0 +1,93 @@
+#ifndef GFX_H
+#define GFX_H
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+
+// Thin drawing layer between the game and OpenGL.
+// The calls mirror the fixed-function API the game was written against.
+// LEGACY forwards each call straight to OpenGL (the default).
+// CORE emulates it on an OpenGL 3.3 core profile context:
+// - immediate mode is batched into a streaming VBO;
+// - display lists become static VBOs;
+// - the matrix stack lives on the CPU;
+// - lighting and texturing are done by one small shader.
+// Both backends draw the same scene from the same calls.
+
+namespace Gfx {
+    enum class Backend {
+        LEGACY,     // Fixed-function OpenGL (compatibility context)
+        CORE        // OpenGL 3.3 core profile
+    };
+
+    // Set up the backend (needs a current GL context of the matching kind)
+    bool init(Backend backend);
+
+    // Release shaders and buffers
+    void cleanup();
+
+    Backend getBackend();
+    const char* getBackendName();
+
+    // ===== Immediate mode =====
+    void begin(GLenum mode);
+    void end();
+    void vertex2f(float x, float y);
+    void vertex3f(float x, float y, float z);
+    void color3f(float r, float g, float b);
+    void color4f(float r, float g, float b, float a);
+    void normal3f(float x, float y, float z);
+
+    // ===== Matrix stack =====
+    void matrixMode(GLenum mode);
+    void loadIdentity();
+    void pushMatrix();
+    void popMatrix();
+    void translatef(float x, float y, float z);
+    void rotatef(float angle, float x, float y, float z);
+    void scalef(float x, float y, float z);
+    void multMatrixf(const float* m);
+    void ortho(double left, double right, double bottom, double top, double zNear, double zFar);
+
+    // ===== State =====
+    void enable(GLenum cap);
+    void disable(GLenum cap);
+    void lineWidth(float width);
+    void shadeModel(GLenum mode);
+    void colorMaterial(GLenum face, GLenum mode);
+    void lightfv(GLenum light, GLenum pname, const float* params);
+
+    // ===== Display lists =====
+    // Lists may contain geometry and colors only (no matrix or state calls)
+    GLuint genLists(GLsizei range);
+    void newList(GLuint list, GLenum mode);
+    void endList();
+    void callList(GLuint list);
+    // Lists base + offsets[i], in one glCallLists on LEGACY
+    void callLists(GLuint base, GLsizei count, const GLuint* offsets);
+    void deleteLists(GLuint list, GLsizei range);
+
+    // ===== Instanced meshes =====
+    // A mesh is recorded once between beginMesh() and endMesh() with the
+    // immediate mode calls (GL_LINES, GL_TRIANGLES and GL_QUADS only; no
+    // matrix or state calls), then drawn at many positions in one batch.
+    // CORE draws the instances with glDrawArraysInstanced; LEGACY expands
+    // them into one vertex array on the CPU.
+    GLuint beginMesh();
+    void endMesh();
+    // offsets holds count (x, y, z) translations; the mesh's last color stays current
+    void drawMeshInstanced(GLuint mesh, const float* offsets, int count);
+    void deleteMesh(GLuint mesh);
+
+    // ===== Text =====
+    // 2D textured quads from interleaved x, y, u, v (4 vertices per quad)
+    void drawTexturedQuads2D(const float* xyuv, int vertexCount);
+
+    // Upload a single-channel coverage texture to the bound GL_TEXTURE_2D
+    void texImageAlpha(int width, int height, const void* pixels);
+}
+
+#endif // GFX_H
@@ -1,75 +1,167 @@
 #include "Grid.h"
+#include "Frustum.h"
+#include "LevelOfDetail.h"
+#include "RenderQueue.h"
 #ifdef _WIN32
 #define NOMINMAX
 #include <windows.h>
 #endif
 #include <GL/gl.h>
+#include "Gfx.h"
+#include <cmath>
+#include <algorithm>
+
+// std::min takes it by reference, which needs a definition in C++11
+const int Grid::CHUNK_CELLS;
 
 Grid::Grid(float aCellNum, float aCellSize) 
-    : cellNum(aCellNum), cellSize(aCellSize) {
+    : cellNum(aCellNum), cellSize(aCellSize), borderList(0), visibleChunks(0) {
 }
 
-void Grid::update() {
-    float size = cellNum * cellSize;
-    float halfSize = size / 2.0f;
+Grid::~Grid() {
+    for (auto& entry : chunkLists) {
+        Gfx::deleteLists(entry.second, 1);
+    }
+    if (borderList != 0) {
+        Gfx::deleteLists(borderList, 1);
+    }
+}
 
-    // Draw grid lines
-    glColor3f(0.78f, 0.78f, 0.78f);
-    glBegin(GL_LINES);
+unsigned int Grid::getChunkList(int cellsX, int cellsZ) {
+    std::pair<int, int> key(cellsX, cellsZ);
+    auto it = chunkLists.find(key);
+    if (it != chunkLists.end()) return it->second;
     
-    for (int i = 0; i <= cellNum; i++) {
-        float x = -halfSize + i * cellSize;
-        glVertex3f(x, 0.0f, -halfSize);
-        glVertex3f(x, 0.0f, halfSize);
-
-        float z = -halfSize + i * cellSize;
-        glVertex3f(-halfSize, 0.0f, z);
-        glVertex3f(halfSize, 0.0f, z);
+    // Lines of one chunk, starting at its minimum corner
+    float sizeX = cellsX * cellSize;
+    float sizeZ = cellsZ * cellSize;
+    
+    GLuint list = Gfx::genLists(1);
+    Gfx::newList(list, GL_COMPILE);
+    Gfx::begin(GL_LINES);
+    for (int i = 0; i <= cellsX; i++) {
+        float x = i * cellSize;
+        Gfx::vertex3f(x, 0.0f, 0.0f);
+        Gfx::vertex3f(x, 0.0f, sizeZ);
+    }
+    for (int i = 0; i <= cellsZ; i++) {
+        float z = i * cellSize;
+        Gfx::vertex3f(0.0f, 0.0f, z);
+        Gfx::vertex3f(sizeX, 0.0f, z);
     }
+    Gfx::end();
+    Gfx::endList();
+    
+    chunkLists[key] = list;
+    return list;
+}
+
+void Grid::update(RenderQueue& queue, const Frustum& frustum, const LevelOfDetail& lod) {
+    int cells = (int)cellNum;
+    float size = cellNum * cellSize;
+    float halfSize = size / 2.0f;
+    float chunkSize = CHUNK_CELLS * cellSize;
+    int chunkCount = (cells + CHUNK_CELLS - 1) / CHUNK_CELLS;
+    
+    // Only chunks within render distance of the camera are considered,
+    // so the cost does not depend on the total grid size
+    float range = lod.getRenderDistance();
+    int minChunkX = std::max(0, (int)std::floor((lod.getEyeX() - range + halfSize) / chunkSize));
+    int maxChunkX = std::min(chunkCount - 1, (int)std::floor((lod.getEyeX() + range + halfSize) / chunkSize));
+    int minChunkZ = std::max(0, (int)std::floor((lod.getEyeZ() - range + halfSize) / chunkSize));
+    int maxChunkZ = std::min(chunkCount - 1, (int)std::floor((lod.getEyeZ() + range + halfSize) / chunkSize));
     
-    glEnd();
+    // Queue grid lines
+    frameChunks.clear();
+    visibleChunks = 0;
     
-    // Draw border walls to show the edge
-    glColor3f(1.0f, 0.2f, 0.2f);
-    glLineWidth(3.0f);
+    for (int cz = minChunkZ; cz <= maxChunkZ; cz++) {
+        for (int cx = minChunkX; cx <= maxChunkX; cx++) {
+            float x0 = -halfSize + cx * chunkSize;
+            float z0 = -halfSize + cz * chunkSize;
+            int cellsX = std::min(CHUNK_CELLS, cells - cx * CHUNK_CELLS);
+            int cellsZ = std::min(CHUNK_CELLS, cells - cz * CHUNK_CELLS);
+            float x1 = x0 + cellsX * cellSize;
+            float z1 = z0 + cellsZ * cellSize;
+            
+            if (lod.distanceToBox(x0, 0.0f, z0, x1, 0.0f, z1) > range) continue;
+            if (!frustum.isBoxVisible(x0, 0.0f, z0, x1, 0.0f, z1)) continue;
+            
+            ChunkDraw chunk;
+            chunk.x = x0;
+            chunk.z = z0;
+            chunk.list = getChunkList(cellsX, cellsZ);
+            frameChunks.push_back(chunk);
+            
+            queue.submit(RenderState::lineState(1.0f), (x0 + x1) / 2, 0.0f, (z0 + z1) / 2,
+                         &Grid::drawChunkItem, this, visibleChunks);
+            visibleChunks++;
+        }
+    }
+    
+    // Border walls to show the edge
+    if (borderList == 0) {
+        borderList = Gfx::genLists(1);
+        Gfx::newList(borderList, GL_COMPILE);
+        drawBorder(halfSize);
+        Gfx::endList();
+    }
+    queue.submit(RenderState::lineState(3.0f), 0.0f, 0.0f, 0.0f, &Grid::drawBorderItem, this, 0);
+}
+
+void Grid::drawChunkItem(void* owner, int index) {
+    const ChunkDraw& chunk = static_cast<Grid*>(owner)->frameChunks[index];
+    Gfx::color3f(0.78f, 0.78f, 0.78f);
+    Gfx::pushMatrix();
+    Gfx::translatef(chunk.x, 0.0f, chunk.z);
+    Gfx::callList(chunk.list);
+    Gfx::popMatrix();
+}
+
+void Grid::drawBorderItem(void* owner, int index) {
+    (void)index;  // Only one border
+    Gfx::callList(static_cast<Grid*>(owner)->borderList);
+}
+
+void Grid::drawBorder(float halfSize) {
+    Gfx::color3f(1.0f, 0.2f, 0.2f);
     float wallHeight = 5.0f;
     
-    glBegin(GL_LINES);
+    Gfx::begin(GL_LINES);
     
     // North wall
-    glVertex3f(-halfSize, 0.0f, -halfSize);
-    glVertex3f(-halfSize, wallHeight, -halfSize);
-    glVertex3f(halfSize, 0.0f, -halfSize);
-    glVertex3f(halfSize, wallHeight, -halfSize);
-    glVertex3f(-halfSize, wallHeight, -halfSize);
-    glVertex3f(halfSize, wallHeight, -halfSize);
+    Gfx::vertex3f(-halfSize, 0.0f, -halfSize);
+    Gfx::vertex3f(-halfSize, wallHeight, -halfSize);
+    Gfx::vertex3f(halfSize, 0.0f, -halfSize);
+    Gfx::vertex3f(halfSize, wallHeight, -halfSize);
+    Gfx::vertex3f(-halfSize, wallHeight, -halfSize);
+    Gfx::vertex3f(halfSize, wallHeight, -halfSize);
     
     // South wall
-    glVertex3f(-halfSize, 0.0f, halfSize);
-    glVertex3f(-halfSize, wallHeight, halfSize);
-    glVertex3f(halfSize, 0.0f, halfSize);
-    glVertex3f(halfSize, wallHeight, halfSize);
-    glVertex3f(-halfSize, wallHeight, halfSize);
-    glVertex3f(halfSize, wallHeight, halfSize);
+    Gfx::vertex3f(-halfSize, 0.0f, halfSize);
+    Gfx::vertex3f(-halfSize, wallHeight, halfSize);
+    Gfx::vertex3f(halfSize, 0.0f, halfSize);
+    Gfx::vertex3f(halfSize, wallHeight, halfSize);
+    Gfx::vertex3f(-halfSize, wallHeight, halfSize);
+    Gfx::vertex3f(halfSize, wallHeight, halfSize);
     
     // West wall
-    glVertex3f(-halfSize, 0.0f, -halfSize);
-    glVertex3f(-halfSize, wallHeight, -halfSize);
-    glVertex3f(-halfSize, 0.0f, halfSize);
-    glVertex3f(-halfSize, wallHeight, halfSize);
-    glVertex3f(-halfSize, wallHeight, -halfSize);
-    glVertex3f(-halfSize, wallHeight, halfSize);
+    Gfx::vertex3f(-halfSize, 0.0f, -halfSize);
+    Gfx::vertex3f(-halfSize, wallHeight, -halfSize);
+    Gfx::vertex3f(-halfSize, 0.0f, halfSize);
+    Gfx::vertex3f(-halfSize, wallHeight, halfSize);
+    Gfx::vertex3f(-halfSize, wallHeight, -halfSize);
+    Gfx::vertex3f(-halfSize, wallHeight, halfSize);
     
     // East wall
-    glVertex3f(halfSize, 0.0f, -halfSize);
-    glVertex3f(halfSize, wallHeight, -halfSize);
-    glVertex3f(halfSize, 0.0f, halfSize);
-    glVertex3f(halfSize, wallHeight, halfSize);
-    glVertex3f(halfSize, wallHeight, -halfSize);
-    glVertex3f(halfSize, wallHeight, halfSize);
+    Gfx::vertex3f(halfSize, 0.0f, -halfSize);
+    Gfx::vertex3f(halfSize, wallHeight, -halfSize);
+    Gfx::vertex3f(halfSize, 0.0f, halfSize);
+    Gfx::vertex3f(halfSize, wallHeight, halfSize);
+    Gfx::vertex3f(halfSize, wallHeight, -halfSize);
+    Gfx::vertex3f(halfSize, wallHeight, halfSize);
     
-    glEnd();
-    glLineWidth(1.0f);
+    Gfx::end();
 }
 
 bool Grid::isOutOfBounds(float x, float z) const {
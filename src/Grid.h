@@ -1,15 +1,48 @@
 #ifndef GRID_H
 #define GRID_H
 
+#include <map>
+#include <utility>
+#include <vector>
+
+class Frustum;
+class LevelOfDetail;
+class RenderQueue;
+
 class Grid {
 private:
     float cellNum;
     float cellSize;
+    
+    // Ground lines are drawn in square chunks of CHUNK_CELLS cells. Chunks of
+    // the same size share one display list that is drawn translated to each
+    // chunk, so a huge grid needs only a handful of lists.
+    static const int CHUNK_CELLS = 32;
+    std::map<std::pair<int, int>, unsigned int> chunkLists;  // (cellsX, cellsZ) -> list
+    unsigned int borderList;        // Border walls, compiled once
+    int visibleChunks;              // Chunks drawn in the last update
+    
+    struct ChunkDraw {
+        float x, z;                 // Minimum corner
+        unsigned int list;
+    };
+    std::vector<ChunkDraw> frameChunks;  // Chunks queued this frame
+    
+    unsigned int getChunkList(int cellsX, int cellsZ);
+    void drawBorder(float halfSize);
+    
+    // Render queue callbacks
+    static void drawChunkItem(void* owner, int index);
+    static void drawBorderItem(void* owner, int index);
 
 public:
     Grid(float aCellNum, float aCellSize);
-    void update();
+    ~Grid();
+    
+    // Queue the chunks near the camera that are inside the view
+    void update(RenderQueue& queue, const Frustum& frustum, const LevelOfDetail& lod);
     bool isOutOfBounds(float x, float z) const;
+    int getVisibleChunkCount() const { return visibleChunks; }
 };
 
 #endif // GRID_H
@@ -0,0 +1,166 @@
+#include "InputReplay.h"
+#include "StateHash.h"
+#include <cstring>
+
+namespace {
+    const char MAGIC[4] = {'P', 'K', 'R', 'P'};
+    const unsigned int VERSION = 2;   // 2: stress launcher count in the header
+    
+    // Bit of each button in a step's flag word
+    enum InputFlag {
+        FLAG_FORWARD      = 1 << 0,
+        FLAG_BACKWARD     = 1 << 1,
+        FLAG_LEFT         = 1 << 2,
+        FLAG_RIGHT        = 1 << 3,
+        FLAG_CROUCH       = 1 << 4,
+        FLAG_WALL_RUN     = 1 << 5,
+        FLAG_JUMP         = 1 << 6,
+        FLAG_TOGGLE_TIMER = 1 << 7,
+        FLAG_RESET_STATS  = 1 << 8,
+        FLAG_RESTART      = 1 << 9,
+        FLAG_DEV_MODE     = 1 << 10
+    };
+    
+    unsigned int packFlags(const TickInput& input) {
+        unsigned int flags = 0;
+        if (input.forward) flags |= FLAG_FORWARD;
+        if (input.backward) flags |= FLAG_BACKWARD;
+        if (input.left) flags |= FLAG_LEFT;
+        if (input.right) flags |= FLAG_RIGHT;
+        if (input.crouch) flags |= FLAG_CROUCH;
+        if (input.wallRun) flags |= FLAG_WALL_RUN;
+        if (input.jump) flags |= FLAG_JUMP;
+        if (input.toggleTimer) flags |= FLAG_TOGGLE_TIMER;
+        if (input.resetStats) flags |= FLAG_RESET_STATS;
+        if (input.restart) flags |= FLAG_RESTART;
+        if (input.devMode) flags |= FLAG_DEV_MODE;
+        return flags;
+    }
+    
+    void unpackFlags(unsigned int flags, TickInput& input) {
+        input.forward = (flags & FLAG_FORWARD) != 0;
+        input.backward = (flags & FLAG_BACKWARD) != 0;
+        input.left = (flags & FLAG_LEFT) != 0;
+        input.right = (flags & FLAG_RIGHT) != 0;
+        input.crouch = (flags & FLAG_CROUCH) != 0;
+        input.wallRun = (flags & FLAG_WALL_RUN) != 0;
+        input.jump = (flags & FLAG_JUMP) != 0;
+        input.toggleTimer = (flags & FLAG_TOGGLE_TIMER) != 0;
+        input.resetStats = (flags & FLAG_RESET_STATS) != 0;
+        input.restart = (flags & FLAG_RESTART) != 0;
+        input.devMode = (flags & FLAG_DEV_MODE) != 0;
+    }
+    
+    unsigned int floatBits(float v) {
+        unsigned int bits;
+        memcpy(&bits, &v, sizeof(bits));
+        return bits;
+    }
+    
+    float bitsFloat(unsigned int bits) {
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+}
+
+void TickInput::hashInto(StateHash& hash) const {
+    hash.addInt(static_cast<int>(packFlags(*this)));
+    hash.addFloat(lookX);
+    hash.addFloat(lookY);
+    hash.addFloat(speed);
+    hash.addFloat(gravity);
+    hash.addFloat(jumpForce);
+    hash.addFloat(sensitivity);
+}
+
+InputReplay::InputReplay() : file(nullptr), mode(Mode::NONE) {}
+
+InputReplay::~InputReplay() {
+    close();
+}
+
+void InputReplay::writeU32(unsigned int v) {
+    unsigned char bytes[4] = {
+        static_cast<unsigned char>(v), static_cast<unsigned char>(v >> 8),
+        static_cast<unsigned char>(v >> 16), static_cast<unsigned char>(v >> 24)
+    };
+    fwrite(bytes, 1, sizeof(bytes), file);
+}
+
+bool InputReplay::readU32(unsigned int& v) {
+    unsigned char bytes[4];
+    if (fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes)) return false;
+    v = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<unsigned int>(bytes[3]) << 24);
+    return true;
+}
+
+bool InputReplay::startRecording(const char* path, unsigned int seed, bool analyticArrows,
+                                 int stressLaunchers) {
+    close();
+    file = fopen(path, "wb");
+    if (!file) return false;
+    mode = Mode::RECORD;
+    
+    fwrite(MAGIC, 1, sizeof(MAGIC), file);
+    writeU32(VERSION);
+    writeU32(seed);
+    writeU32(analyticArrows ? 1 : 0);
+    writeU32(static_cast<unsigned int>(stressLaunchers));
+    return true;
+}
+
+bool InputReplay::startPlayback(const char* path, unsigned int& seed, bool& analyticArrows,
+                                int& stressLaunchers) {
+    close();
+    file = fopen(path, "rb");
+    if (!file) return false;
+    
+    char magic[4];
+    unsigned int version = 0, analytic = 0, stress = 0;
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !readU32(version) || version != VERSION ||
+        !readU32(seed) || !readU32(analytic) || !readU32(stress)) {
+        close();
+        return false;
+    }
+    analyticArrows = analytic != 0;
+    stressLaunchers = static_cast<int>(stress);
+    mode = Mode::PLAYBACK;
+    return true;
+}
+
+void InputReplay::close() {
+    if (file) fclose(file);
+    file = nullptr;
+    mode = Mode::NONE;
+}
+
+void InputReplay::write(const TickInput& input) {
+    if (mode != Mode::RECORD) return;
+    writeU32(packFlags(input));
+    writeU32(floatBits(input.lookX));
+    writeU32(floatBits(input.lookY));
+    writeU32(floatBits(input.speed));
+    writeU32(floatBits(input.gravity));
+    writeU32(floatBits(input.jumpForce));
+    writeU32(floatBits(input.sensitivity));
+}
+
+bool InputReplay::read(TickInput& input) {
+    if (mode != Mode::PLAYBACK) return false;
+    
+    unsigned int words[7];
+    for (unsigned int& word : words) {
+        if (!readU32(word)) return false;
+    }
+    unpackFlags(words[0], input);
+    input.lookX = bitsFloat(words[1]);
+    input.lookY = bitsFloat(words[2]);
+    input.speed = bitsFloat(words[3]);
+    input.gravity = bitsFloat(words[4]);
+    input.jumpForce = bitsFloat(words[5]);
+    input.sensitivity = bitsFloat(words[6]);
+    return true;
+}
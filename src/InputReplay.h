@@ -0,0 +1,65 @@
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include <cstdio>
+
+class StateHash;
+
+// Everything one simulation step takes from the player and the menu.
+// Deterministic runs apply input only at step boundaries through this,
+// so a run is fully described by its seed and one TickInput per step.
+struct TickInput {
+    bool forward, backward, left, right;
+    bool crouch;            // Crouch key held
+    bool wallRun;           // Wall run key held
+    bool jump;              // Jump pressed since the last step
+    bool toggleTimer;       // Timer key pressed since the last step
+    bool resetStats;        // Reset key pressed since the last step
+    bool restart;           // Menu restart since the last step
+    bool devMode;
+    float lookX, lookY;     // Mouse movement since the last step, in pixels
+    
+    // Settings the physics depends on
+    float speed, gravity, jumpForce, sensitivity;
+    
+    TickInput() : forward(false), backward(false), left(false), right(false),
+                  crouch(false), wallRun(false), jump(false), toggleTimer(false),
+                  resetStats(false), restart(false), devMode(false),
+                  lookX(0), lookY(0), speed(0), gravity(0), jumpForce(0), sensitivity(0) {}
+    
+    void hashInto(StateHash& hash) const;
+};
+
+// Binary stream of TickInputs (--record / --replay). The header holds the
+// seed, arrow mode and stress launcher count, so a replay rebuilds the same
+// run from the file alone.
+// Floats are stored by their bit pattern, little-endian.
+class InputReplay {
+private:
+    enum class Mode { NONE, RECORD, PLAYBACK };
+    
+    FILE* file;
+    Mode mode;
+    
+    void writeU32(unsigned int v);
+    bool readU32(unsigned int& v);
+
+public:
+    InputReplay();
+    ~InputReplay();
+    
+    // Both return false (and leave the stream closed) if the file can't be used
+    bool startRecording(const char* path, unsigned int seed, bool analyticArrows,
+                        int stressLaunchers);
+    bool startPlayback(const char* path, unsigned int& seed, bool& analyticArrows,
+                       int& stressLaunchers);
+    void close();
+    
+    bool isRecording() const { return mode == Mode::RECORD; }
+    bool isPlaying() const { return mode == Mode::PLAYBACK; }
+    
+    void write(const TickInput& input);
+    bool read(TickInput& input);    // False at the end of the recording
+};
+
+#endif // INPUT_REPLAY_H
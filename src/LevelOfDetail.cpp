@@ -0,0 +1,41 @@
+#include "LevelOfDetail.h"
+#include <cmath>
+#include <algorithm>
+
+LevelOfDetail::LevelOfDetail() : eyeX(0), eyeY(0), eyeZ(0), renderDistance(0) {
+    update(0, 0, 0, 3000.0f);  // Default render distance
+}
+
+void LevelOfDetail::update(float x, float y, float z, float distance) {
+    eyeX = x;
+    eyeY = y;
+    eyeZ = z;
+    renderDistance = distance;
+    
+    // Fractions of the render distance, with floors so the lowest
+    // setting still shows nearby hazards
+    decorationDistance = std::max(250.0f, renderDistance * 0.35f);
+    laserDistance = std::max(200.0f, renderDistance * 0.25f);
+    figureTierDistance = std::max(50.0f, renderDistance * 0.1f);
+}
+
+float LevelOfDetail::distanceTo(float x, float y, float z) const {
+    float dx = x - eyeX;
+    float dy = y - eyeY;
+    float dz = z - eyeZ;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+float LevelOfDetail::distanceToBox(float minX, float minY, float minZ,
+                                   float maxX, float maxY, float maxZ) const {
+    // Closest point on the box to the camera
+    float cx = std::max(minX, std::min(eyeX, maxX));
+    float cy = std::max(minY, std::min(eyeY, maxY));
+    float cz = std::max(minZ, std::min(eyeZ, maxZ));
+    return distanceTo(cx, cy, cz);
+}
+
+int LevelOfDetail::figureTierDrop(float distance) const {
+    int drop = (int)(distance / figureTierDistance);
+    return std::min(drop, 3);
+}
@@ -0,0 +1,37 @@
+#ifndef LEVEL_OF_DETAIL_H
+#define LEVEL_OF_DETAIL_H
+
+// Distance-based detail tiers. All thresholds scale with the render distance
+// setting, so a shorter render distance also drops detail sooner.
+class LevelOfDetail {
+private:
+    float eyeX, eyeY, eyeZ;         // Camera position from the last update
+    float renderDistance;
+    float decorationDistance;       // Spikes and checkpoint borders beyond this are skipped
+    float laserDistance;            // Launcher laser lines beyond this are skipped
+    float figureTierDistance;       // Figure meshes lose one tier per multiple of this
+    
+public:
+    LevelOfDetail();
+    
+    // Recompute the tiers for the current camera and render distance
+    void update(float eyeX, float eyeY, float eyeZ, float renderDistance);
+    
+    // Distance from the camera to a point / to the closest point of a box
+    float distanceTo(float x, float y, float z) const;
+    float distanceToBox(float minX, float minY, float minZ,
+                        float maxX, float maxY, float maxZ) const;
+    
+    float getEyeX() const { return eyeX; }
+    float getEyeY() const { return eyeY; }
+    float getEyeZ() const { return eyeZ; }
+    float getRenderDistance() const { return renderDistance; }
+    
+    bool showDecorations(float distance) const { return distance <= decorationDistance; }
+    bool showLaser(float distance) const { return distance <= laserDistance; }
+    
+    // How many mesh tiers to drop for a figure at this distance (0 = full detail)
+    int figureTierDrop(float distance) const;
+};
+
+#endif // LEVEL_OF_DETAIL_H
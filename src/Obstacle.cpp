@@ -1,15 +1,26 @@
 #include "Obstacle.h"
+#include "SpikeRenderer.h"
+#include "RenderQueue.h"
 #ifdef _WIN32
 #define NOMINMAX
 #include <windows.h>
 #endif
 #include <GL/gl.h>
+#include "Gfx.h"
+#include <algorithm>
 #include <cmath>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// Frustum test against a box's bounds; extraTop covers geometry drawn above it
+static bool isBoxInView(const Frustum& frustum, const Box& box, float extraTop = 0.0f) {
+    return frustum.isBoxVisible(box.x - box.width / 2, box.y, box.z - box.depth / 2,
+                                box.x + box.width / 2, box.y + box.height + extraTop,
+                                box.z + box.depth / 2);
+}
+
 bool Box::checkCollision(float px, float py, float pz, float radius) const {
     // AABB collision - check if sphere overlaps box
     float halfW = width / 2;
@@ -29,7 +40,99 @@ bool Box::checkCollision(float px, float py, float pz, float radius) const {
     return distSquared < (radius * radius);
 }
 
-ObstacleCourse::ObstacleCourse() : glowPhase(0.0f) {
+// ===== Swept sphere helpers =====
+// A sphere moving along a segment hits a box when its center enters the box
+// grown by the radius with rounded edges. That shape is the union of three
+// boxes (grown along one axis each), twelve edge cylinders and eight corner
+// spheres, so the first entry into it is the earliest entry into any of them.
+// Each helper lowers t to its entry time if that is in [0, t).
+// Starting exactly on a surface only counts when moving inward.
+
+static void enterBox(const float p[3], const float d[3], const float lo[3], const float hi[3], float& t) {
+    float tEnter = 0.0f, tExit = 1.0f;
+    for (int a = 0; a < 3; a++) {
+        if (d[a] == 0.0f) {
+            if (p[a] <= lo[a] || p[a] >= hi[a]) return;  // Parallel and outside
+            continue;
+        }
+        float t1 = (lo[a] - p[a]) / d[a];
+        float t2 = (hi[a] - p[a]) / d[a];
+        if (t1 > t2) std::swap(t1, t2);
+        tEnter = std::max(tEnter, t1);
+        tExit = std::min(tExit, t2);
+        if (tEnter >= tExit) return;
+    }
+    if (tEnter < t) t = tEnter;
+}
+
+// Ray against a sphere (n = 3) or a circle in two of the axes (n = 2)
+static void enterRound(const float* p, const float* d, const float* c, int n, float r, float& t) {
+    float a = 0.0f, b = 0.0f, k = -r * r;
+    for (int i = 0; i < n; i++) {
+        float m = p[i] - c[i];
+        a += d[i] * d[i];
+        b += m * d[i];
+        k += m * m;
+    }
+    if (b >= 0.0f || a == 0.0f) return;  // Moving away, or not moving here
+    if (k <= 0.0f) {
+        t = 0.0f;                        // Starts inside, moving inward
+        return;
+    }
+    float disc = b * b - a * k;
+    if (disc < 0.0f) return;
+    float tHit = (-b - std::sqrt(disc)) / a;
+    if (tHit < t) t = tHit;
+}
+
+float Box::sweepSphere(float px, float py, float pz, float dx, float dy, float dz, float radius) const {
+    if (checkCollision(px, py, pz, radius)) return 1.0f;
+    
+    const float p[3] = { px, py, pz };
+    const float d[3] = { dx, dy, dz };
+    const float lo[3] = { x - width / 2, y, z - depth / 2 };
+    const float hi[3] = { x + width / 2, y + height, z + depth / 2 };
+    float t = 1.0f;
+    
+    // Faces: the box grown by the radius along one axis at a time
+    for (int a = 0; a < 3; a++) {
+        float glo[3] = { lo[0], lo[1], lo[2] };
+        float ghi[3] = { hi[0], hi[1], hi[2] };
+        glo[a] -= radius;
+        ghi[a] += radius;
+        enterBox(p, d, glo, ghi, t);
+    }
+    
+    // Edges: cylinders along axis a through the corners of the other two
+    for (int a = 0; a < 3; a++) {
+        int u = (a + 1) % 3, v = (a + 2) % 3;
+        const float pp[2] = { p[u], p[v] };
+        const float dd[2] = { d[u], d[v] };
+        for (int corner = 0; corner < 4; corner++) {
+            const float c[2] = { (corner & 1) ? hi[u] : lo[u], (corner & 2) ? hi[v] : lo[v] };
+            float tEdge = t;
+            enterRound(pp, dd, c, 2, radius, tEdge);
+            if (tEdge < t) {
+                float along = p[a] + d[a] * tEdge;
+                if (along > lo[a] && along < hi[a]) t = tEdge;
+            }
+        }
+    }
+    
+    // Corners
+    for (int corner = 0; corner < 8; corner++) {
+        const float c[3] = { (corner & 1) ? hi[0] : lo[0],
+                             (corner & 2) ? hi[1] : lo[1],
+                             (corner & 4) ? hi[2] : lo[2] };
+        enterRound(p, d, c, 3, radius, t);
+    }
+    
+    return t;
+}
+
+ObstacleCourse::ObstacleCourse() : glowPhase(0.0f), currentGlow(0.0f),
+                                   staticListBase(0), staticListCount(0), staticCompiled(false),
+                                   collisionHash(64.0f), floorMap(32.0f), spikeRenderer(new SpikeRenderer()) {
     // Extended parkour course along the EDGE of the grid (negative Z side)
     // Grid is 800x800 (-400 to +400), parkour runs along Z = -300 to -350
     
@@ -175,51 +278,106 @@ ObstacleCourse::ObstacleCourse() : glowPhase(0.0f) {
     // Victory platform
     goalBox = Box(4350, -10, courseZ, 150, 10, 100, 0.2f, 0.9f, 0.2f);
     obstacles.push_back(goalBox);
+    
+    buildCollisionIndex();
 }
 
-bool ObstacleCourse::isOnGoal(float x, float y, float z) {
-    float halfW = goalBox.width / 2;
-    float halfD = goalBox.depth / 2;
-    float topY = goalBox.y + goalBox.height;
-    
-    // Check if player is on or above the goal platform (within reasonable height)
-    // Player Y is the foot position, but in third person the reported Y includes offset
-    return (x >= goalBox.x - halfW && x <= goalBox.x + halfW &&
-            z >= goalBox.z - halfD && z <= goalBox.z + halfD &&
-            y >= topY - 10 && y <= topY + 150);  // More forgiving height range
+ObstacleCourse::~ObstacleCourse() {
+    releaseStaticGeometry();
+    delete spikeRenderer;
 }
 
-int ObstacleCourse::isOnCheckpoint(float x, float y, float z) {
+void ObstacleCourse::buildCollisionIndex() {
+    obstacleBounds.assign(obstacles);
+    collisionHash.clear();
+    for (size_t i = 0; i < obstacles.size(); i++) {
+        const Box& box = obstacles[i];
+        collisionHash.insert(static_cast<int>(i),
+                             box.x - box.width / 2, box.z - box.depth / 2,
+                             box.x + box.width / 2, box.z + box.depth / 2);
+    }
+    
+    // Every box can be stood on; the margin lets the player stand on edges.
+    // Rays see every box as well.
+    const float standingMargin = 10.0f;
+    floorMap.clear();
+    rayTree.clear();
+    const std::vector<Box>* groups[] = { &obstacles, &checkpoints, &deathZones };
+    for (const auto* group : groups) {
+        for (const auto& box : *group) {
+            float halfW = box.width / 2 + standingMargin;
+            float halfD = box.depth / 2 + standingMargin;
+            floorMap.addSurface(box.y + box.height,
+                                box.x - halfW, box.z - halfD,
+                                box.x + halfW, box.z + halfD);
+            rayTree.addBox(box.x - box.width / 2, box.y, box.z - box.depth / 2,
+                           box.x + box.width / 2, box.y + box.height, box.z + box.depth / 2);
+        }
+    }
+    floorMap.build();
+    rayTree.build();
+    
+    // Triggers span the box footprint and a window above its top that holds
+    // the player's Y (the head, playerHeight = 100 above the feet)
+    triggers.clear();
     for (size_t i = 0; i < checkpoints.size(); i++) {
         const Box& cp = checkpoints[i];
-        float halfW = cp.width / 2;
-        float halfD = cp.depth / 2;
         float topY = cp.y + cp.height;
-        
-        // Player Y includes playerHeight (100), so check a larger range
-        if (x >= cp.x - halfW && x <= cp.x + halfW &&
-            z >= cp.z - halfD && z <= cp.z + halfD &&
-            y >= topY && y <= topY + 150) {
-            return (int)i;
-        }
+        triggers.add(TriggerType::CHECKPOINT, static_cast<int>(i),
+                     cp.x - cp.width / 2, topY, cp.z - cp.depth / 2,
+                     cp.x + cp.width / 2, topY + 150, cp.z + cp.depth / 2);
+    }
+    for (size_t i = 0; i < deathZones.size(); i++) {
+        const Box& dz = deathZones[i];
+        float topY = dz.y + dz.height;
+        triggers.add(TriggerType::DEATH_ZONE, static_cast<int>(i),
+                     dz.x - dz.width / 2, topY, dz.z - dz.depth / 2,
+                     dz.x + dz.width / 2, topY + 150, dz.z + dz.depth / 2);
     }
-    return -1;
+    // The goal is more forgiving and also counts slightly below its top
+    float goalTop = goalBox.y + goalBox.height;
+    triggers.add(TriggerType::GOAL, 0,
+                 goalBox.x - goalBox.width / 2, goalTop - 10, goalBox.z - goalBox.depth / 2,
+                 goalBox.x + goalBox.width / 2, goalTop + 150, goalBox.z + goalBox.depth / 2);
 }
 
-bool ObstacleCourse::isOnDeathZone(float x, float y, float z) {
+void ObstacleCourse::compileStaticGeometry() {
+    releaseStaticGeometry();
+    staticCompiled = true;
+    
+    GLsizei count = static_cast<GLsizei>(obstacles.size() + deathZones.size());
+    if (count == 0) return;
+    
+    staticListBase = Gfx::genLists(count);
+    if (staticListBase == 0) return;  // No list space - render() falls back to immediate mode
+    
+    // Boxes never change after construction, so record each one once
+    GLuint list = staticListBase;
+    for (const auto& box : obstacles) {
+        Gfx::newList(list++, GL_COMPILE);
+        drawBox(box);
+        Gfx::endList();
+    }
     for (const auto& dz : deathZones) {
-        float halfW = dz.width / 2;
-        float halfD = dz.depth / 2;
-        float topY = dz.y + dz.height;
-        
-        // Player Y includes playerHeight (100), so check a larger range
-        if (x >= dz.x - halfW && x <= dz.x + halfW &&
-            z >= dz.z - halfD && z <= dz.z + halfD &&
-            y >= topY && y <= topY + 150) {
-            return true;
-        }
+        Gfx::newList(list++, GL_COMPILE);
+        drawBox(dz);
+        Gfx::endList();
+    }
+    staticListCount = static_cast<unsigned int>(count);
+}
+
+void ObstacleCourse::releaseStaticGeometry() {
+    if (staticListBase != 0) {
+        Gfx::deleteLists(staticListBase, static_cast<GLsizei>(staticListCount));
+        staticListBase = 0;
     }
-    return false;
+    staticListCount = 0;
+    visibleListOffsets.clear();
+    staticCompiled = false;
+}
+
+void ObstacleCourse::invalidateCompiledGeometry() {
+    releaseStaticGeometry();
 }
 
 void ObstacleCourse::getCheckpointPosition(int index, float& outX, float& outY, float& outZ) {
@@ -232,95 +390,142 @@ void ObstacleCourse::getCheckpointPosition(int index, float& outX, float& outY,
     }
 }
 
-void ObstacleCourse::render(float deltaTime) {
+void ObstacleCourse::render(RenderQueue& queue, float deltaTime,
+                            const Frustum& frustum, const LevelOfDetail& lod) {
     // Update glow animation
     glowPhase += deltaTime * 3.0f;
     if (glowPhase > 2.0f * M_PI) glowPhase -= 2.0f * M_PI;
-    float glow = 0.5f + 0.5f * std::sin(glowPhase);
-    
-    // Render normal obstacles
-    for (const auto& box : obstacles) {
-        drawBox(box);
-    }
+    currentGlow = 0.5f + 0.5f * std::sin(glowPhase);
     
-    // Render checkpoints with glow effect
-    for (const auto& cp : checkpoints) {
-        drawGlowingBox(cp, glow);
+    // Build the compiled course lazily so it is created with a current GL context
+    if (!staticCompiled) {
+        compileStaticGeometry();
     }
     
-    // Render death zones with spikes
-    for (const auto& dz : deathZones) {
-        drawBox(dz);
-        drawSpikes(dz);
-    }
-}
-
-bool ObstacleCourse::checkCollision(float x, float y, float z, float radius) {
-    for (const auto& box : obstacles) {
-        if (box.checkCollision(x, y, z, radius)) {
-            return true;
+    cullStats.reset();
+    
+    // Queue normal obstacles and death zone bases that are inside the view as
+    // one item, sorted at the center of the visible boxes
+    visibleListOffsets.clear();
+    float sumX = 0, sumY = 0, sumZ = 0;
+    size_t staticCount = obstacles.size() + deathZones.size();
+    for (size_t i = 0; i < staticCount; i++) {
+        const Box& box = getStaticBox(i);
+        if (isBoxInView(frustum, box)) {
+            visibleListOffsets.push_back(static_cast<unsigned int>(i));
+            sumX += box.x;
+            sumY += box.y + box.height / 2;
+            sumZ += box.z;
         }
     }
-    return false;
-}
-
-float ObstacleCourse::getFloorHeight(float x, float z, float currentY) {
-    float maxFloor = 0.0f;
-    float standingMargin = 10.0f;  // Extra margin for standing on edges
+    cullStats.visible += (int)visibleListOffsets.size();
+    cullStats.culled += (int)(staticCount - visibleListOffsets.size());
     
-    // Check normal obstacles
-    for (const auto& box : obstacles) {
-        float halfW = box.width / 2 + standingMargin;
-        float halfD = box.depth / 2 + standingMargin;
-        
-        if (x >= box.x - halfW && x <= box.x + halfW &&
-            z >= box.z - halfD && z <= box.z + halfD) {
-            
-            float topY = box.y + box.height;
-            
-            if (currentY >= topY && topY > maxFloor) {
-                maxFloor = topY;
-            }
-        }
+    if (!visibleListOffsets.empty()) {
+        float n = static_cast<float>(visibleListOffsets.size());
+        queue.submit(RenderState::solid(), sumX / n, sumY / n, sumZ / n,
+                     &ObstacleCourse::drawStaticItem, this, 0);
     }
     
-    // Check checkpoints
-    for (const auto& cp : checkpoints) {
-        float halfW = cp.width / 2 + standingMargin;
-        float halfD = cp.depth / 2 + standingMargin;
+    // Checkpoints glow (animated, so not compiled)
+    // The glow border sits just above the top face and is dropped when far away
+    for (size_t i = 0; i < checkpoints.size(); i++) {
+        const Box& cp = checkpoints[i];
+        if (!isBoxInView(frustum, cp, 1.0f)) {
+            cullStats.culled++;
+            continue;
+        }
+        cullStats.visible++;
         
-        if (x >= cp.x - halfW && x <= cp.x + halfW &&
-            z >= cp.z - halfD && z <= cp.z + halfD) {
-            
-            float topY = cp.y + cp.height;
-            
-            if (currentY >= topY && topY > maxFloor) {
-                maxFloor = topY;
-            }
+        float centerY = cp.y + cp.height / 2;
+        queue.submit(RenderState::solid(), cp.x, centerY, cp.z,
+                     &ObstacleCourse::drawCheckpointItem, this, (int)i);
+        
+        float distance = lod.distanceToBox(cp.x - cp.width / 2, cp.y, cp.z - cp.depth / 2,
+                                           cp.x + cp.width / 2, cp.y + cp.height, cp.z + cp.depth / 2);
+        if (lod.showDecorations(distance)) {
+            queue.submit(RenderState::lineState(3.0f), cp.x, centerY, cp.z,
+                         &ObstacleCourse::drawCheckpointBorderItem, this, (int)i);
         }
     }
     
-    // Check death zones (they also have floor)
-    for (const auto& dz : deathZones) {
-        float halfW = dz.width / 2 + standingMargin;
-        float halfD = dz.depth / 2 + standingMargin;
-        
-        if (x >= dz.x - halfW && x <= dz.x + halfW &&
-            z >= dz.z - halfD && z <= dz.z + halfD) {
-            
-            float topY = dz.y + dz.height;
-            
-            if (currentY >= topY && topY > maxFloor) {
-                maxFloor = topY;
-            }
+    // Spikes on top of the death zones (batches rebuilt only for changed zones)
+    spikeRenderer->sync(deathZones);
+    spikeRenderer->render(queue, frustum, lod);
+}
+
+const Box& ObstacleCourse::getStaticBox(size_t index) const {
+    // Same order as the compiled lists: obstacles, then death zones
+    if (index < obstacles.size()) return obstacles[index];
+    return deathZones[index - obstacles.size()];
+}
+
+void ObstacleCourse::drawStaticItem(void* owner, int) {
+    ObstacleCourse* course = static_cast<ObstacleCourse*>(owner);
+    const std::vector<unsigned int>& visible = course->visibleListOffsets;
+    if (course->staticListBase != 0) {
+        Gfx::callLists(course->staticListBase, static_cast<GLsizei>(visible.size()), visible.data());
+    } else {
+        // No list space: draw the same boxes in immediate mode
+        for (unsigned int index : visible) {
+            course->drawBox(course->getStaticBox(index));
         }
     }
-    
-    return maxFloor;
+}
+
+void ObstacleCourse::drawCheckpointItem(void* owner, int index) {
+    ObstacleCourse* course = static_cast<ObstacleCourse*>(owner);
+    course->drawGlowingBox(course->checkpoints[index], course->currentGlow);
+}
+
+void ObstacleCourse::drawCheckpointBorderItem(void* owner, int index) {
+    ObstacleCourse* course = static_cast<ObstacleCourse*>(owner);
+    course->drawGlowBorder(course->checkpoints[index], course->currentGlow);
+}
+
+bool ObstacleCourse::checkCollision(float x, float y, float z, float radius) {
+    // Only boxes sharing a cell with the sphere's footprint can touch it
+    collisionHash.query(x - radius, z - radius, x + radius, z + radius, collisionCandidates);
+    return obstacleBounds.anySphereOverlap(x, y, z, radius,
+                                           collisionCandidates.data(), collisionCandidates.size());
+}
+
+float ObstacleCourse::sweepSphere(float x, float y, float z, float dx, float dy, float dz, float radius) {
+    // Candidates come from every cell the swept sphere passes over
+    collisionHash.query(std::min(x, x + dx) - radius, std::min(z, z + dz) - radius,
+                        std::max(x, x + dx) + radius, std::max(z, z + dz) + radius,
+                        collisionCandidates);
+    float t = 1.0f;
+    for (int index : collisionCandidates) {
+        t = std::min(t, obstacles[index].sweepSphere(x, y, z, dx, dy, dz, radius));
+    }
+    return t;
+}
+
+bool ObstacleCourse::raycast(float ox, float oy, float oz, float dx, float dy, float dz,
+                             float maxDistance, RayHit& hit) const {
+    return rayTree.raycast(ox, oy, oz, dx, dy, dz, maxDistance, hit);
+}
+
+bool ObstacleCourse::segmentCast(float x0, float y0, float z0, float x1, float y1, float z1,
+                                 RayHit& hit) const {
+    return rayTree.segmentCast(x0, y0, z0, x1, y1, z1, hit);
+}
+
+const Box& ObstacleCourse::getHitBox(const RayHit& hit) const {
+    size_t index = static_cast<size_t>(hit.index);
+    if (index < obstacles.size()) return obstacles[index];
+    index -= obstacles.size();
+    if (index < checkpoints.size()) return checkpoints[index];
+    return deathZones[index - checkpoints.size()];
+}
+
+float ObstacleCourse::getFloorHeight(float x, float z, float currentY) {
+    return floorMap.getFloorHeight(x, z, currentY);
 }
 
 void ObstacleCourse::drawBox(const Box& box) {
-    glColor3f(box.r, box.g, box.b);
+    Gfx::color3f(box.r, box.g, box.b);
     
     float x1 = box.x - box.width / 2;
     float x2 = box.x + box.width / 2;
@@ -329,97 +534,51 @@ void ObstacleCourse::drawBox(const Box& box) {
     float z1 = box.z - box.depth / 2;
     float z2 = box.z + box.depth / 2;
     
-    glBegin(GL_QUADS);
+    Gfx::begin(GL_QUADS);
     
     // Front face
-    glVertex3f(x1, y1, z2);
-    glVertex3f(x2, y1, z2);
-    glVertex3f(x2, y2, z2);
-    glVertex3f(x1, y2, z2);
+    Gfx::vertex3f(x1, y1, z2);
+    Gfx::vertex3f(x2, y1, z2);
+    Gfx::vertex3f(x2, y2, z2);
+    Gfx::vertex3f(x1, y2, z2);
     
     // Back face
-    glVertex3f(x2, y1, z1);
-    glVertex3f(x1, y1, z1);
-    glVertex3f(x1, y2, z1);
-    glVertex3f(x2, y2, z1);
+    Gfx::vertex3f(x2, y1, z1);
+    Gfx::vertex3f(x1, y1, z1);
+    Gfx::vertex3f(x1, y2, z1);
+    Gfx::vertex3f(x2, y2, z1);
     
     // Top face
-    glVertex3f(x1, y2, z2);
-    glVertex3f(x2, y2, z2);
-    glVertex3f(x2, y2, z1);
-    glVertex3f(x1, y2, z1);
+    Gfx::vertex3f(x1, y2, z2);
+    Gfx::vertex3f(x2, y2, z2);
+    Gfx::vertex3f(x2, y2, z1);
+    Gfx::vertex3f(x1, y2, z1);
     
     // Bottom face
-    glVertex3f(x1, y1, z1);
-    glVertex3f(x2, y1, z1);
-    glVertex3f(x2, y1, z2);
-    glVertex3f(x1, y1, z2);
+    Gfx::vertex3f(x1, y1, z1);
+    Gfx::vertex3f(x2, y1, z1);
+    Gfx::vertex3f(x2, y1, z2);
+    Gfx::vertex3f(x1, y1, z2);
     
     // Right face
-    glVertex3f(x2, y1, z2);
-    glVertex3f(x2, y1, z1);
-    glVertex3f(x2, y2, z1);
-    glVertex3f(x2, y2, z2);
+    Gfx::vertex3f(x2, y1, z2);
+    Gfx::vertex3f(x2, y1, z1);
+    Gfx::vertex3f(x2, y2, z1);
+    Gfx::vertex3f(x2, y2, z2);
     
     // Left face
-    glVertex3f(x1, y1, z1);
-    glVertex3f(x1, y1, z2);
-    glVertex3f(x1, y2, z2);
-    glVertex3f(x1, y2, z1);
+    Gfx::vertex3f(x1, y1, z1);
+    Gfx::vertex3f(x1, y1, z2);
+    Gfx::vertex3f(x1, y2, z2);
+    Gfx::vertex3f(x1, y2, z1);
     
-    glEnd();
-}
-
-void ObstacleCourse::drawSpikes(const Box& box) {
-    float x1 = box.x - box.width / 2;
-    float x2 = box.x + box.width / 2;
-    float topY = box.y + box.height;
-    float z1 = box.z - box.depth / 2;
-    float z2 = box.z + box.depth / 2;
-    
-    // Spike parameters
-    float spikeHeight = 12.0f;
-    float spikeSpacing = 10.0f;
-    
-    // Dark metal color for spikes
-    glColor3f(0.25f, 0.25f, 0.28f);
-    
-    // Draw spikes in a grid pattern
-    for (float sx = x1 + spikeSpacing / 2; sx < x2; sx += spikeSpacing) {
-        for (float sz = z1 + spikeSpacing / 2; sz < z2; sz += spikeSpacing) {
-            float baseSize = 3.5f;
-            
-            glBegin(GL_TRIANGLES);
-            
-            // Front face
-            glVertex3f(sx, topY + spikeHeight, sz);
-            glVertex3f(sx - baseSize, topY, sz + baseSize);
-            glVertex3f(sx + baseSize, topY, sz + baseSize);
-            
-            // Right face
-            glVertex3f(sx, topY + spikeHeight, sz);
-            glVertex3f(sx + baseSize, topY, sz + baseSize);
-            glVertex3f(sx + baseSize, topY, sz - baseSize);
-            
-            // Back face
-            glVertex3f(sx, topY + spikeHeight, sz);
-            glVertex3f(sx + baseSize, topY, sz - baseSize);
-            glVertex3f(sx - baseSize, topY, sz - baseSize);
-            
-            // Left face
-            glVertex3f(sx, topY + spikeHeight, sz);
-            glVertex3f(sx - baseSize, topY, sz - baseSize);
-            glVertex3f(sx - baseSize, topY, sz + baseSize);
-            
-            glEnd();
-        }
-    }
+    Gfx::end();
 }
 
 void ObstacleCourse::drawGlowingBox(const Box& box, float glow) {
     // Main box with pulsing brightness
     float brightness = 0.6f + 0.4f * glow;
-    glColor3f(box.r * brightness, box.g * brightness, box.b * brightness);
+    Gfx::color3f(box.r * brightness, box.g * brightness, box.b * brightness);
     
     float x1 = box.x - box.width / 2;
     float x2 = box.x + box.width / 2;
@@ -428,58 +587,63 @@ void ObstacleCourse::drawGlowingBox(const Box& box, float glow) {
     float z1 = box.z - box.depth / 2;
     float z2 = box.z + box.depth / 2;
     
-    glBegin(GL_QUADS);
+    Gfx::begin(GL_QUADS);
     
     // Front face
-    glVertex3f(x1, y1, z2);
-    glVertex3f(x2, y1, z2);
-    glVertex3f(x2, y2, z2);
-    glVertex3f(x1, y2, z2);
+    Gfx::vertex3f(x1, y1, z2);
+    Gfx::vertex3f(x2, y1, z2);
+    Gfx::vertex3f(x2, y2, z2);
+    Gfx::vertex3f(x1, y2, z2);
     
     // Back face
-    glVertex3f(x2, y1, z1);
-    glVertex3f(x1, y1, z1);
-    glVertex3f(x1, y2, z1);
-    glVertex3f(x2, y2, z1);
+    Gfx::vertex3f(x2, y1, z1);
+    Gfx::vertex3f(x1, y1, z1);
+    Gfx::vertex3f(x1, y2, z1);
+    Gfx::vertex3f(x2, y2, z1);
     
     // Top face (brighter)
-    glColor3f(box.r * brightness * 1.2f, box.g * brightness * 1.2f, box.b * brightness * 1.2f);
-    glVertex3f(x1, y2, z2);
-    glVertex3f(x2, y2, z2);
-    glVertex3f(x2, y2, z1);
-    glVertex3f(x1, y2, z1);
+    Gfx::color3f(box.r * brightness * 1.2f, box.g * brightness * 1.2f, box.b * brightness * 1.2f);
+    Gfx::vertex3f(x1, y2, z2);
+    Gfx::vertex3f(x2, y2, z2);
+    Gfx::vertex3f(x2, y2, z1);
+    Gfx::vertex3f(x1, y2, z1);
     
     // Bottom face
-    glColor3f(box.r * brightness, box.g * brightness, box.b * brightness);
-    glVertex3f(x1, y1, z1);
-    glVertex3f(x2, y1, z1);
-    glVertex3f(x2, y1, z2);
-    glVertex3f(x1, y1, z2);
+    Gfx::color3f(box.r * brightness, box.g * brightness, box.b * brightness);
+    Gfx::vertex3f(x1, y1, z1);
+    Gfx::vertex3f(x2, y1, z1);
+    Gfx::vertex3f(x2, y1, z2);
+    Gfx::vertex3f(x1, y1, z2);
     
     // Right face
-    glVertex3f(x2, y1, z2);
-    glVertex3f(x2, y1, z1);
-    glVertex3f(x2, y2, z1);
-    glVertex3f(x2, y2, z2);
+    Gfx::vertex3f(x2, y1, z2);
+    Gfx::vertex3f(x2, y1, z1);
+    Gfx::vertex3f(x2, y2, z1);
+    Gfx::vertex3f(x2, y2, z2);
     
     // Left face
-    glVertex3f(x1, y1, z1);
-    glVertex3f(x1, y1, z2);
-    glVertex3f(x1, y2, z2);
-    glVertex3f(x1, y2, z1);
+    Gfx::vertex3f(x1, y1, z1);
+    Gfx::vertex3f(x1, y1, z2);
+    Gfx::vertex3f(x1, y2, z2);
+    Gfx::vertex3f(x1, y2, z1);
     
-    glEnd();
+    Gfx::end();
+}
+
+void ObstacleCourse::drawGlowBorder(const Box& box, float glow) {
+    float x1 = box.x - box.width / 2;
+    float x2 = box.x + box.width / 2;
+    float z1 = box.z - box.depth / 2;
+    float z2 = box.z + box.depth / 2;
     
-    // Draw glow border/ring on top
-    glColor3f(0.3f + 0.7f * glow, 1.0f, 0.4f + 0.3f * glow);
-    float borderY = y2 + 0.5f;
+    // Glow border/ring on top (line width comes from the render queue)
+    Gfx::color3f(0.3f + 0.7f * glow, 1.0f, 0.4f + 0.3f * glow);
+    float borderY = box.y + box.height + 0.5f;
     float borderInset = 2.0f;
-    glLineWidth(3.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex3f(x1 + borderInset, borderY, z1 + borderInset);
-    glVertex3f(x2 - borderInset, borderY, z1 + borderInset);
-    glVertex3f(x2 - borderInset, borderY, z2 - borderInset);
-    glVertex3f(x1 + borderInset, borderY, z2 - borderInset);
-    glEnd();
-    glLineWidth(1.0f);
+    Gfx::begin(GL_LINE_LOOP);
+    Gfx::vertex3f(x1 + borderInset, borderY, z1 + borderInset);
+    Gfx::vertex3f(x2 - borderInset, borderY, z1 + borderInset);
+    Gfx::vertex3f(x2 - borderInset, borderY, z2 - borderInset);
+    Gfx::vertex3f(x1 + borderInset, borderY, z2 - borderInset);
+    Gfx::end();
 }
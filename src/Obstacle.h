@@ -1,7 +1,15 @@
 #ifndef OBSTACLE_H
 #define OBSTACLE_H
 
+#include <cstddef>
 #include <vector>
+#include "Frustum.h"
+#include "LevelOfDetail.h"
+#include "SpatialHash.h"
+#include "FloorMap.h"
+#include "BoxSoA.h"
+#include "BVH.h"
+#include "TriggerSystem.h"
 
 enum class BoxType {
     NORMAL,
@@ -21,8 +29,16 @@ struct Box {
         : x(x), y(y), z(z), width(w), height(h), depth(d), r(r), g(g), b(b), type(t) {}
     
     bool checkCollision(float px, float py, float pz, float radius) const;
+    
+    // Fraction of the move (dx, dy, dz) at which a sphere starting at
+    // (px, py, pz) first touches the box, or 1 if it never does.
+    // A sphere that already overlaps the box at the start is ignored.
+    float sweepSphere(float px, float py, float pz, float dx, float dy, float dz, float radius) const;
 };
 
+class SpikeRenderer;  // Forward declaration
+class RenderQueue;
+
 class ObstacleCourse {
 private:
     std::vector<Box> obstacles;
@@ -30,19 +46,65 @@ private:
     std::vector<Box> deathZones;
     Box goalBox;  // The finish platform
     float glowPhase;  // For animated glow effect
+    float currentGlow;  // Glow value for this frame's queued checkpoints
+    
+    // Compiled course: one display list per static box (obstacles, then death
+    // zone bases) in a contiguous block. The visible ones are queued as one
+    // item and drawn with a single glCallLists.
+    unsigned int staticListBase;
+    unsigned int staticListCount;
+    std::vector<unsigned int> visibleListOffsets;  // Static boxes inside the frustum this frame
+    bool staticCompiled;
+    
+    CullStats cullStats;  // Boxes drawn/skipped in the last render
+    
+    // Broadphase for checkCollision: obstacle indices bucketed by X/Z cell
+    SpatialHash collisionHash;
+    std::vector<int> collisionCandidates;  // Reused query result
+    BoxSoA obstacleBounds;  // Obstacle bounds for the batched narrowphase
+    
+    // Box tops of obstacles, checkpoints and death zones for getFloorHeight
+    FloorMap floorMap;
+    
+    // Ray queries over all boxes: obstacles, then checkpoints, then death zones
+    BVH rayTree;
+    
+    // Volumes above checkpoints, death zones and the goal
+    TriggerSystem triggers;
+    
+    SpikeRenderer* spikeRenderer;  // Pre-baked spike batches for death zones
+    
+    void buildCollisionIndex();  // Collision hash and floor map, once at load
+    void compileStaticGeometry();
+    void releaseStaticGeometry();
+    const Box& getStaticBox(size_t index) const;  // Obstacles, then death zones
+    
+    // Render queue callbacks
+    static void drawStaticItem(void* owner, int index);  // All visible static boxes
+    static void drawCheckpointItem(void* owner, int index);
+    static void drawCheckpointBorderItem(void* owner, int index);
     
 public:
     ObstacleCourse();
-    void render(float deltaTime);
+    ~ObstacleCourse();
+    void render(RenderQueue& queue, float deltaTime, const Frustum& frustum, const LevelOfDetail& lod);
+    void invalidateCompiledGeometry();  // Rebuild static lists on next render
     bool checkCollision(float x, float y, float z, float radius);
+    // Time of impact (0..1) of a sphere moving by (dx, dy, dz); 1 = no hit
+    float sweepSphere(float x, float y, float z, float dx, float dy, float dz, float radius);
     float getFloorHeight(float x, float z, float currentY);
-    bool isOnGoal(float x, float y, float z);  // Check if player reached the goal
-    int isOnCheckpoint(float x, float y, float z);  // Returns checkpoint index or -1
-    bool isOnDeathZone(float x, float y, float z);  // Check if player is on death plate
+    
+    // Nearest box on a ray (t in units of the direction) or segment (t = 0..1)
+    bool raycast(float ox, float oy, float oz, float dx, float dy, float dz,
+                 float maxDistance, RayHit& hit) const;
+    bool segmentCast(float x0, float y0, float z0, float x1, float y1, float z1, RayHit& hit) const;
+    const Box& getHitBox(const RayHit& hit) const;
+    TriggerSystem& getTriggers() { return triggers; }  // Update with the player position
     void getCheckpointPosition(int index, float& outX, float& outY, float& outZ);
     void drawBox(const Box& box);
-    void drawSpikes(const Box& box);
     void drawGlowingBox(const Box& box, float glow);
+    void drawGlowBorder(const Box& box, float glow);
+    const CullStats& getCullStats() const { return cullStats; }
 };
 
 #endif // OBSTACLE_H
@@ -1,9 +1,13 @@
 #include "Projectile.h"
+#include "RenderQueue.h"
+#include "StateHash.h"
+#include "WorkerPool.h"
 #ifdef _WIN32
 #define NOMINMAX
 #include <windows.h>
 #endif
 #include <GL/gl.h>
+#include "Gfx.h"
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
@@ -15,21 +19,21 @@
 
 ProjectileManager::ProjectileManager(float gridSize) {
     gridHalfSize = gridSize / 2.0f;
+    interpolation = 1.0f;
+    analytic = false;
+    arrowClock = 0.0;
+    lastStep = 0.0f;
+    workerPool = nullptr;
+    liveArrows = 0;
+    laneStep = 0.0f;
     
-    // Initialize random seed
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned>(time(nullptr)));
-        seeded = true;
-    }
+    // Random seed from the clock; deterministic runs call setSeed
+    setSeed(static_cast<unsigned int>(time(nullptr)));
     
     // Arrow parameters
     arrowLength = 60.0f;
     arrowRadius = 8.0f;
     
-    // Pre-allocate some arrows
-    arrows.reserve(50);
-    
     // Parkour course is at Z = -320
     float courseZ = -320.0f;
     float launcherZ = 100.0f;  // Launchers positioned in front (positive Z)
@@ -74,249 +78,532 @@ ProjectileManager::ProjectileManager(float gridSize) {
     // At X = 2400-2500
     launchers.push_back(ArrowLauncher(2420, 40, launcherZ, 40.0f, 0.8f, 750.0f));
     launchers.push_back(ArrowLauncher(2500, 95, launcherZ, 95.0f, 0.8f, 750.0f));
+    
+    for (int i = 0; i < MESH_COUNT; i++) meshes[i] = 0;
+    
+    buildLanes();
+}
+
+ProjectileManager::~ProjectileManager() {
+    for (int i = 0; i < MESH_COUNT; i++) {
+        if (meshes[i] != 0) Gfx::deleteMesh(meshes[i]);
+    }
+    delete workerPool;
+}
+
+void ProjectileManager::buildLanes() {
+    lanes.clear();
+    lanesByX.clear();
+    for (size_t i = 0; i < launchers.size(); i++) {
+        lanes.push_back(ArrowLane(launchers[i].x));
+        lanes.back().reserve(getLaneCapacity(i));
+        lanesByX.push_back(static_cast<int>(i));
+    }
+    std::sort(lanesByX.begin(), lanesByX.end(),
+              [this](int a, int b) { return lanes[a].x < lanes[b].x; });
+    buildFireQueue();
+}
+
+void ProjectileManager::buildFireQueue() {
+    fireQueue.clear();
+    for (size_t i = 0; i < launchers.size(); i++) {
+        fireQueue.push_back(FireEvent(launchers[i].nextFireTime, static_cast<int>(i)));
+    }
+    std::make_heap(fireQueue.begin(), fireQueue.end(), &ProjectileManager::firesLater);
+}
+
+bool ProjectileManager::firesLater(const FireEvent& a, const FireEvent& b) {
+    // Ties go to the lower index, so the firing order never depends on the heap
+    if (a.time != b.time) return a.time > b.time;
+    return a.launcher > b.launcher;
+}
+
+size_t ProjectileManager::getLaneCapacity(size_t launcherIndex) const {
+    // An arrow lives for its travel time, and one leaves every fire interval.
+    // One more because a step spawns before it retires.
+    const ArrowLauncher& launcher = launchers[launcherIndex];
+    float travelTime = (launcher.z + 450.0f) / launcher.arrowSpeed;
+    return static_cast<size_t>(travelTime / launcher.fireInterval) + 2;
+}
+
+void ArrowLane::reserve(size_t n) {
+    if (n <= slots.size()) return;
+    size_t size = 4;
+    while (size < n) size *= 2;
+    linearize();
+    slots.resize(size);
+}
+
+void ArrowLane::push(const Arrow& arrow) {
+    if (count == slots.size()) reserve(count + 1);
+    slots[(head + count) & (slots.size() - 1)] = arrow;
+    count++;
+}
+
+void ArrowLane::popFront() {
+    head = (head + 1) & (slots.size() - 1);
+    count--;
+}
+
+void ArrowLane::clear() {
+    head = 0;
+    count = 0;
+}
+
+Arrow* ArrowLane::linearize() {
+    // The ring is slots[head..end) then slots[0..head): rotate head to 0
+    if (head != 0) {
+        std::rotate(slots.begin(), slots.begin() + head, slots.end());
+        head = 0;
+    }
+    return slots.data();
+}
+
+void ProjectileManager::setSeed(unsigned int seed) {
+    // xorshift never leaves the zero state
+    rngState = seed != 0 ? seed : 0x9E3779B9u;
+}
+
+unsigned int ProjectileManager::nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
 }
 
 float ProjectileManager::randomFloat(float min, float max) {
-    return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
+    // Top 24 bits give every float in [0, 1) the same spacing
+    float unit = static_cast<float>(nextRandom() >> 8) / 16777216.0f;
+    return min + unit * (max - min);
 }
 
-void ProjectileManager::spawnArrowFromLauncher(ArrowLauncher& launcher) {
+void ProjectileManager::spawnArrowFromLauncher(size_t launcherIndex, double fireTime, double stepStart) {
+    const ArrowLauncher& launcher = launchers[launcherIndex];
     Arrow arrow;
     
+    // Stepped arrows move a whole step in this update. Start them where an
+    // arrow fired at fireTime would have been at the start of the step (behind
+    // the launcher), so the step ends with them at their exact position.
     arrow.x = launcher.x;
-    arrow.z = launcher.z;
+    arrow.z = launcher.z + launcher.arrowSpeed * static_cast<float>(fireTime - stepStart);
+    arrow.prevZ = launcher.z;  // Drawn from the launcher until it has moved
     arrow.y = launcher.targetHeight;
     arrow.height = launcher.targetHeight;
     arrow.speed = launcher.arrowSpeed;
-    arrow.active = true;
+    arrow.spawnTime = fireTime;
+    arrow.spawnZ = launcher.z;
+    
+    // Spawned at the launcher, behind (higher Z than) everything in flight
+    ArrowLane& lane = lanes[launcherIndex];
+    if (!lane.empty() && lane.back().speed != arrow.speed) {
+        lane.mixedSpeeds = true;
+    }
+    lane.push(arrow);
+    liveArrows++;
+}
+
+float ProjectileManager::getArrowZ(const Arrow& arrow) const {
+    if (!analytic) return arrow.z;
+    return arrow.spawnZ - arrow.speed * static_cast<float>(arrowClock - arrow.spawnTime);
+}
+
+float ProjectileManager::getStepStartZ(const Arrow& arrow) const {
+    // An arrow fired during the step starts at its launcher
+    double time = std::max(arrowClock - lastStep, arrow.spawnTime);
+    return arrow.spawnZ - arrow.speed * static_cast<float>(time - arrow.spawnTime);
+}
+
+float ProjectileManager::getDrawZ(const Arrow& arrow) const {
+    if (!analytic) return arrow.prevZ + (arrow.z - arrow.prevZ) * interpolation;
     
-    arrows.push_back(arrow);
+    // Evaluate the motion at the render time instead of blending two states.
+    // Arrows fired after that time are still at their launcher.
+    double time = std::max(arrowClock - (1.0f - interpolation) * lastStep, arrow.spawnTime);
+    return arrow.spawnZ - arrow.speed * static_cast<float>(time - arrow.spawnTime);
+}
+
+void ProjectileManager::setAnalytic(bool enabled) {
+    analytic = enabled;
+    reset();
 }
 
 void ProjectileManager::update(float deltaTime) {
-    // Update each launcher's timer and spawn arrows
-    for (auto& launcher : launchers) {
-        launcher.timer += deltaTime;
-        if (launcher.timer >= launcher.fireInterval) {
-            spawnArrowFromLauncher(launcher);
-            launcher.timer = 0.0f;
-        }
+    // Fire every shot due by the end of this step, and only touch those
+    // launchers. A launcher can fire more than once in a long step.
+    double stepStart = arrowClock;
+    double stepEnd = arrowClock + deltaTime;
+    while (!fireQueue.empty() && fireQueue.front().time <= stepEnd) {
+        std::pop_heap(fireQueue.begin(), fireQueue.end(), &ProjectileManager::firesLater);
+        FireEvent& event = fireQueue.back();
+        ArrowLauncher& launcher = launchers[event.launcher];
+        
+        spawnArrowFromLauncher(event.launcher, event.time, stepStart);
+        
+        launcher.nextFireTime = event.time + launcher.fireInterval;
+        event.time = launcher.nextFireTime;
+        std::push_heap(fireQueue.begin(), fireQueue.end(), &ProjectileManager::firesLater);
     }
     
-    // Update all arrows
-    for (auto& arrow : arrows) {
-        if (!arrow.active) continue;
+    arrowClock = stepEnd;
+    lastStep = deltaTime;
+    
+    // Lanes are independent from here on. Split them into fixed chunks
+    // (the same split with or without threads) and merge each chunk's
+    // counts in order afterwards.
+    laneStep = deltaTime;
+    int laneCount = static_cast<int>(lanes.size());
+    partitions.assign((laneCount + LANE_CHUNK - 1) / LANE_CHUNK, LanePartition());
+    
+    if (liveArrows >= PARALLEL_ARROW_THRESHOLD) {
+        // Threads are only started once a course is big enough to use them
+        if (!workerPool) workerPool = new WorkerPool();
+        workerPool->run(laneCount, LANE_CHUNK, &ProjectileManager::updateLanesTask, this);
+    } else {
+        updateLanes(0, laneCount);
+    }
+    
+    for (const auto& partition : partitions) {
+        counters.arrowUpdates += partition.arrowUpdates;
+        liveArrows -= partition.retired;
+    }
+}
+
+void ProjectileManager::updateLanesTask(void* owner, int begin, int end) {
+    static_cast<ProjectileManager*>(owner)->updateLanes(begin, end);
+}
+
+void ProjectileManager::updateLanes(int begin, int end) {
+    for (int index = begin; index < end; index++) {
+        ArrowLane& lane = lanes[index];
+        LanePartition& partition = partitions[index / LANE_CHUNK];
         
-        // Move arrow forward (negative Z direction towards parkour)
-        arrow.z -= arrow.speed * deltaTime;
+        partition.arrowUpdates += static_cast<long long>(lane.size());
+        if (analytic) {
+            // Nothing moves. Only lanes that mixed speeds can fall out of order.
+            if (lane.mixedSpeeds) restoreOrder(lane);
+        } else {
+            bool ordered = true;
+            for (size_t i = 0; i < lane.size(); i++) {
+                Arrow& arrow = lane[i];
+                
+                // Move arrow forward (negative Z direction towards parkour).
+                // One fired during this step starts behind its launcher, but
+                // is drawn from the launcher.
+                arrow.prevZ = std::min(arrow.z, arrow.spawnZ);
+                arrow.z -= arrow.speed * laneStep;
+                
+                if (i > 0 && arrow.z < lane[i - 1].z) ordered = false;
+            }
+            
+            // A faster arrow (after a difficulty change) can overtake a slower one
+            if (!ordered) restoreOrder(lane);
+        }
         
-        // Deactivate if past the parkour area (Z < -400)
-        if (arrow.z < -450) {
-            arrow.active = false;
+        // Retire arrows past the parkour area (Z < -450). The lane is in Z
+        // order, so they are all at the front.
+        while (!lane.empty() && getArrowZ(lane.front()) < -450) {
+            lane.popFront();
+            partition.retired++;
         }
-    }
-    
-    // Remove inactive arrows periodically to prevent memory buildup
-    static int cleanupCounter = 0;
-    if (++cleanupCounter > 120) {  // Every ~2 seconds at 60fps
-        arrows.erase(
-            std::remove_if(arrows.begin(), arrows.end(), 
-                [](const Arrow& a) { return !a.active; }),
-            arrows.end()
-        );
-        cleanupCounter = 0;
+        if (lane.empty()) lane.mixedSpeeds = false;
     }
 }
 
-void ProjectileManager::drawLauncher(const ArrowLauncher& launcher) {
-    glPushMatrix();
-    glTranslatef(launcher.x, launcher.y, launcher.z);
+void ProjectileManager::restoreOrder(ArrowLane& lane) {
+    size_t count = lane.size();
+    bool ordered = true;
+    for (size_t i = 1; i < count && ordered; i++) {
+        ordered = getArrowZ(lane[i - 1]) <= getArrowZ(lane[i]);
+    }
+    if (ordered) return;
     
+    Arrow* arrows = lane.linearize();
+    std::stable_sort(arrows, arrows + count,
+                     [this](const Arrow& a, const Arrow& b) { return getArrowZ(a) < getArrowZ(b); });
+}
+
+// Mesh geometry below is recorded once around the origin (the launcher or
+// arrow position) and drawn instanced at every visible one.
+
+void ProjectileManager::drawLauncherBody() {
     // Draw launcher body (box shape)
     float size = 25.0f;
     float depth = 40.0f;
     
     // Main body color - dark metallic
-    glColor3f(0.3f, 0.3f, 0.35f);
+    Gfx::color3f(0.3f, 0.3f, 0.35f);
     
-    glBegin(GL_QUADS);
+    Gfx::begin(GL_QUADS);
     // Front face
-    glVertex3f(-size, -size, depth/2);
-    glVertex3f(size, -size, depth/2);
-    glVertex3f(size, size, depth/2);
-    glVertex3f(-size, size, depth/2);
+    Gfx::vertex3f(-size, -size, depth/2);
+    Gfx::vertex3f(size, -size, depth/2);
+    Gfx::vertex3f(size, size, depth/2);
+    Gfx::vertex3f(-size, size, depth/2);
     
     // Back face
-    glVertex3f(size, -size, -depth/2);
-    glVertex3f(-size, -size, -depth/2);
-    glVertex3f(-size, size, -depth/2);
-    glVertex3f(size, size, -depth/2);
+    Gfx::vertex3f(size, -size, -depth/2);
+    Gfx::vertex3f(-size, -size, -depth/2);
+    Gfx::vertex3f(-size, size, -depth/2);
+    Gfx::vertex3f(size, size, -depth/2);
     
     // Top face
-    glVertex3f(-size, size, depth/2);
-    glVertex3f(size, size, depth/2);
-    glVertex3f(size, size, -depth/2);
-    glVertex3f(-size, size, -depth/2);
+    Gfx::vertex3f(-size, size, depth/2);
+    Gfx::vertex3f(size, size, depth/2);
+    Gfx::vertex3f(size, size, -depth/2);
+    Gfx::vertex3f(-size, size, -depth/2);
     
     // Bottom face
-    glVertex3f(-size, -size, -depth/2);
-    glVertex3f(size, -size, -depth/2);
-    glVertex3f(size, -size, depth/2);
-    glVertex3f(-size, -size, depth/2);
+    Gfx::vertex3f(-size, -size, -depth/2);
+    Gfx::vertex3f(size, -size, -depth/2);
+    Gfx::vertex3f(size, -size, depth/2);
+    Gfx::vertex3f(-size, -size, depth/2);
     
     // Right face
-    glVertex3f(size, -size, depth/2);
-    glVertex3f(size, -size, -depth/2);
-    glVertex3f(size, size, -depth/2);
-    glVertex3f(size, size, depth/2);
+    Gfx::vertex3f(size, -size, depth/2);
+    Gfx::vertex3f(size, -size, -depth/2);
+    Gfx::vertex3f(size, size, -depth/2);
+    Gfx::vertex3f(size, size, depth/2);
     
     // Left face
-    glVertex3f(-size, -size, -depth/2);
-    glVertex3f(-size, -size, depth/2);
-    glVertex3f(-size, size, depth/2);
-    glVertex3f(-size, size, -depth/2);
-    glEnd();
+    Gfx::vertex3f(-size, -size, -depth/2);
+    Gfx::vertex3f(-size, -size, depth/2);
+    Gfx::vertex3f(-size, size, depth/2);
+    Gfx::vertex3f(-size, size, -depth/2);
+    Gfx::end();
     
     // Draw barrel (front opening) - red warning color
-    glColor3f(0.8f, 0.2f, 0.2f);
+    Gfx::color3f(0.8f, 0.2f, 0.2f);
     float barrelSize = size * 0.6f;
     
-    glBegin(GL_QUADS);
+    Gfx::begin(GL_QUADS);
     // Front barrel opening
-    glVertex3f(-barrelSize, -barrelSize, depth/2 + 1);
-    glVertex3f(barrelSize, -barrelSize, depth/2 + 1);
-    glVertex3f(barrelSize, barrelSize, depth/2 + 1);
-    glVertex3f(-barrelSize, barrelSize, depth/2 + 1);
-    glEnd();
+    Gfx::vertex3f(-barrelSize, -barrelSize, depth/2 + 1);
+    Gfx::vertex3f(barrelSize, -barrelSize, depth/2 + 1);
+    Gfx::vertex3f(barrelSize, barrelSize, depth/2 + 1);
+    Gfx::vertex3f(-barrelSize, barrelSize, depth/2 + 1);
+    Gfx::end();
+}
+
+void ProjectileManager::drawLauncherStripes() {
+    float size = 25.0f;
+    float depth = 40.0f;
     
     // Draw warning stripes
-    glColor3f(1.0f, 0.8f, 0.0f);  // Yellow warning
-    glLineWidth(3.0f);
-    glBegin(GL_LINES);
+    Gfx::color3f(1.0f, 0.8f, 0.0f);  // Yellow warning
+    Gfx::begin(GL_LINES);
     // Diagonal stripes on front
     for (int i = -2; i <= 2; i++) {
         float offset = i * 10.0f;
-        glVertex3f(-size + offset, -size, depth/2 + 2);
-        glVertex3f(size + offset, size, depth/2 + 2);
+        Gfx::vertex3f(-size + offset, -size, depth/2 + 2);
+        Gfx::vertex3f(size + offset, size, depth/2 + 2);
     }
-    glEnd();
+    Gfx::end();
+}
+
+void ProjectileManager::drawLauncherLaser() {
+    float depth = 40.0f;
     
     // Draw aiming laser/indicator line towards parkour
-    glColor4f(1.0f, 0.0f, 0.0f, 0.5f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINES);
-    glVertex3f(0, 0, depth/2);
-    glVertex3f(0, 0, -300);  // Line pointing towards parkour
-    glEnd();
-    
-    glPopMatrix();
+    Gfx::color4f(1.0f, 0.0f, 0.0f, 0.5f);
+    Gfx::begin(GL_LINES);
+    Gfx::vertex3f(0, 0, depth/2);
+    Gfx::vertex3f(0, 0, -300);  // Line pointing towards parkour
+    Gfx::end();
 }
 
-void ProjectileManager::drawArrow(const Arrow& arrow) {
-    glPushMatrix();
-    glTranslatef(arrow.x, arrow.y, arrow.z);
-    
-    // Rotate to point in -Z direction (towards player)
-    glRotatef(90.0f, 0.0f, 1.0f, 0.0f);
-    
+// Arrow geometry is written along +X (tip at +X). Turning it 90 degrees
+// about Y points it down -Z, the way arrows fly.
+static void arrowVertex(float x, float y, float z) {
+    Gfx::vertex3f(z, y, -x);
+}
+
+void ProjectileManager::drawArrowShaft() {
     // Arrow color - red/orange
-    glColor3f(1.0f, 0.3f, 0.1f);
+    Gfx::color3f(1.0f, 0.3f, 0.1f);
     
     // Draw arrow shaft (cylinder approximation with lines)
-    glLineWidth(3.0f);
-    glBegin(GL_LINES);
+    Gfx::begin(GL_LINES);
     
     // Main shaft
-    glVertex3f(-arrowLength * 0.7f, 0, 0);
-    glVertex3f(arrowLength * 0.3f, 0, 0);
+    arrowVertex(-arrowLength * 0.7f, 0, 0);
+    arrowVertex(arrowLength * 0.3f, 0, 0);
     
     // Shaft thickness (cross pattern)
     float shaftRadius = arrowRadius * 0.3f;
-    glVertex3f(-arrowLength * 0.7f, -shaftRadius, 0);
-    glVertex3f(arrowLength * 0.1f, -shaftRadius, 0);
-    glVertex3f(-arrowLength * 0.7f, shaftRadius, 0);
-    glVertex3f(arrowLength * 0.1f, shaftRadius, 0);
-    glVertex3f(-arrowLength * 0.7f, 0, -shaftRadius);
-    glVertex3f(arrowLength * 0.1f, 0, -shaftRadius);
-    glVertex3f(-arrowLength * 0.7f, 0, shaftRadius);
-    glVertex3f(arrowLength * 0.1f, 0, shaftRadius);
-    
-    glEnd();
-    
+    arrowVertex(-arrowLength * 0.7f, -shaftRadius, 0);
+    arrowVertex(arrowLength * 0.1f, -shaftRadius, 0);
+    arrowVertex(-arrowLength * 0.7f, shaftRadius, 0);
+    arrowVertex(arrowLength * 0.1f, shaftRadius, 0);
+    arrowVertex(-arrowLength * 0.7f, 0, -shaftRadius);
+    arrowVertex(arrowLength * 0.1f, 0, -shaftRadius);
+    arrowVertex(-arrowLength * 0.7f, 0, shaftRadius);
+    arrowVertex(arrowLength * 0.1f, 0, shaftRadius);
+    
+    Gfx::end();
+}
+
+void ProjectileManager::drawArrowHead() {
     // Draw arrowhead (pyramid/cone)
-    glColor3f(0.8f, 0.8f, 0.8f);  // Silver tip
-    glBegin(GL_TRIANGLES);
+    Gfx::color3f(0.8f, 0.8f, 0.8f);  // Silver tip
+    Gfx::begin(GL_TRIANGLES);
     
     float tipX = arrowLength * 0.3f;
     float baseX = arrowLength * 0.1f;
     float headSize = arrowRadius;
     
     // Top face
-    glVertex3f(tipX, 0, 0);
-    glVertex3f(baseX, headSize, 0);
-    glVertex3f(baseX, 0, headSize);
+    arrowVertex(tipX, 0, 0);
+    arrowVertex(baseX, headSize, 0);
+    arrowVertex(baseX, 0, headSize);
     
     // Bottom face
-    glVertex3f(tipX, 0, 0);
-    glVertex3f(baseX, 0, headSize);
-    glVertex3f(baseX, -headSize, 0);
+    arrowVertex(tipX, 0, 0);
+    arrowVertex(baseX, 0, headSize);
+    arrowVertex(baseX, -headSize, 0);
     
     // Left face
-    glVertex3f(tipX, 0, 0);
-    glVertex3f(baseX, -headSize, 0);
-    glVertex3f(baseX, 0, -headSize);
+    arrowVertex(tipX, 0, 0);
+    arrowVertex(baseX, -headSize, 0);
+    arrowVertex(baseX, 0, -headSize);
     
     // Right face
-    glVertex3f(tipX, 0, 0);
-    glVertex3f(baseX, 0, -headSize);
-    glVertex3f(baseX, headSize, 0);
+    arrowVertex(tipX, 0, 0);
+    arrowVertex(baseX, 0, -headSize);
+    arrowVertex(baseX, headSize, 0);
     
-    glEnd();
+    Gfx::end();
     
     // Draw fletching (feathers at back)
-    glColor3f(0.6f, 0.2f, 0.2f);  // Dark red feathers
-    glBegin(GL_TRIANGLES);
+    Gfx::color3f(0.6f, 0.2f, 0.2f);  // Dark red feathers
+    Gfx::begin(GL_TRIANGLES);
     
     float backX = -arrowLength * 0.7f;
     float midX = -arrowLength * 0.5f;
     float featherSize = arrowRadius * 0.8f;
     
     // Top feather
-    glVertex3f(backX, 0, 0);
-    glVertex3f(midX, 0, 0);
-    glVertex3f(midX, featherSize, 0);
+    arrowVertex(backX, 0, 0);
+    arrowVertex(midX, 0, 0);
+    arrowVertex(midX, featherSize, 0);
     
     // Bottom feather
-    glVertex3f(backX, 0, 0);
-    glVertex3f(midX, 0, 0);
-    glVertex3f(midX, -featherSize, 0);
+    arrowVertex(backX, 0, 0);
+    arrowVertex(midX, 0, 0);
+    arrowVertex(midX, -featherSize, 0);
     
     // Side feathers
-    glVertex3f(backX, 0, 0);
-    glVertex3f(midX, 0, 0);
-    glVertex3f(midX, 0, featherSize);
-    
-    glVertex3f(backX, 0, 0);
-    glVertex3f(midX, 0, 0);
-    glVertex3f(midX, 0, -featherSize);
+    arrowVertex(backX, 0, 0);
+    arrowVertex(midX, 0, 0);
+    arrowVertex(midX, 0, featherSize);
     
-    glEnd();
+    arrowVertex(backX, 0, 0);
+    arrowVertex(midX, 0, 0);
+    arrowVertex(midX, 0, -featherSize);
     
-    glPopMatrix();
+    Gfx::end();
 }
 
-void ProjectileManager::render() {
-    // Draw all launchers first
-    for (const auto& launcher : launchers) {
-        drawLauncher(launcher);
+void ProjectileManager::render(RenderQueue& queue, const Frustum& frustum, const LevelOfDetail& lod,
+                               float interpolation) {
+    cullStats.reset();
+    this->interpolation = std::max(0.0f, std::min(1.0f, interpolation));
+    
+    if (meshes[LAUNCHER_BODY_MESH] == 0) buildMeshes();
+    launcherOffsets.clear();
+    laserOffsets.clear();
+    arrowOffsets.clear();
+    
+    // Launchers: bounds include the stripes and the laser line
+    for (size_t i = 0; i < launchers.size(); i++) {
+        const ArrowLauncher& launcher = launchers[i];
+        if (!frustum.isBoxVisible(launcher.x - 45.0f, launcher.y - 25.0f, launcher.z - 300.0f,
+                                  launcher.x + 45.0f, launcher.y + 25.0f, launcher.z + 22.0f)) {
+            cullStats.culled++;
+            continue;
+        }
+        cullStats.visible++;
+        
+        launcherOffsets.push_back(launcher.x);
+        launcherOffsets.push_back(launcher.y);
+        launcherOffsets.push_back(launcher.z);
+        
+        // The laser is skipped when far away
+        float distance = lod.distanceToBox(launcher.x - 25.0f, launcher.y - 25.0f, launcher.z - 20.0f,
+                                           launcher.x + 25.0f, launcher.y + 25.0f, launcher.z + 20.0f);
+        if (lod.showLaser(distance)) {
+            laserOffsets.push_back(launcher.x);
+            laserOffsets.push_back(launcher.y);
+            laserOffsets.push_back(launcher.z);
+        }
     }
     
-    // Draw all active arrows
-    for (const auto& arrow : arrows) {
-        if (arrow.active) {
-            drawArrow(arrow);
+    // Active arrows (tip at -Z, fletching at +Z)
+    for (const auto& lane : lanes) {
+        for (size_t i = 0; i < lane.size(); i++) {
+            const Arrow& arrow = lane[i];
+            float z = getDrawZ(arrow);
+            if (!frustum.isBoxVisible(arrow.x - arrowRadius, arrow.y - arrowRadius, z - arrowLength * 0.3f,
+                                      arrow.x + arrowRadius, arrow.y + arrowRadius, z + arrowLength * 0.7f)) {
+                cullStats.culled++;
+                continue;
+            }
+            cullStats.visible++;
+            
+            arrowOffsets.push_back(arrow.x);
+            arrowOffsets.push_back(arrow.y);
+            arrowOffsets.push_back(z);
         }
     }
+    
+    // One queue item per mesh draws every instance of it
+    submitBatch(queue, RenderState::solid(), LAUNCHER_BODY_MESH);
+    submitBatch(queue, RenderState::lineState(3.0f), LAUNCHER_STRIPES_MESH);
+    submitBatch(queue, RenderState::lineState(2.0f), LAUNCHER_LASER_MESH);
+    submitBatch(queue, RenderState::lineState(3.0f), ARROW_SHAFT_MESH);
+    submitBatch(queue, RenderState::solid(), ARROW_HEAD_MESH);
+}
+
+void ProjectileManager::buildMeshes() {
+    void (ProjectileManager::*emitters[MESH_COUNT])() = {
+        &ProjectileManager::drawLauncherBody,
+        &ProjectileManager::drawLauncherStripes,
+        &ProjectileManager::drawLauncherLaser,
+        &ProjectileManager::drawArrowShaft,
+        &ProjectileManager::drawArrowHead
+    };
+    for (int i = 0; i < MESH_COUNT; i++) {
+        meshes[i] = Gfx::beginMesh();
+        (this->*emitters[i])();
+        Gfx::endMesh();
+    }
+}
+
+const std::vector<float>& ProjectileManager::getBatchOffsets(int mesh) const {
+    switch (mesh) {
+        case LAUNCHER_BODY_MESH:
+        case LAUNCHER_STRIPES_MESH:
+            return launcherOffsets;
+        case LAUNCHER_LASER_MESH:
+            return laserOffsets;
+        default:
+            return arrowOffsets;
+    }
+}
+
+void ProjectileManager::submitBatch(RenderQueue& queue, const RenderState& state, int mesh) {
+    const std::vector<float>& offsets = getBatchOffsets(mesh);
+    if (offsets.empty()) return;
+    
+    // Sorted by its first instance; the batch is one draw either way
+    queue.submit(state, offsets[0], offsets[1], offsets[2],
+                 &ProjectileManager::drawBatchItem, this, mesh);
+}
+
+void ProjectileManager::drawBatchItem(void* owner, int index) {
+    ProjectileManager* manager = static_cast<ProjectileManager*>(owner);
+    const std::vector<float>& offsets = manager->getBatchOffsets(index);
+    Gfx::drawMeshInstanced(manager->meshes[index], offsets.data(),
+                           static_cast<int>(offsets.size() / 3));
 }
 
 bool ProjectileManager::checkPlayerCollision(float playerX, float playerY, float playerZ,
@@ -330,62 +617,162 @@ bool ProjectileManager::checkPlayerCollision(float playerX, float playerY, float
         playerTop = playerBottom + playerHeight * 0.5f;
     }
     
-    for (const auto& arrow : arrows) {
-        if (!arrow.active) continue;
+    // Only lanes close enough in X can hit: binary search the sorted lanes.
+    // The search windows are padded by a unit so float rounding can't drop
+    // a candidate; the exact tests below decide.
+    const float pad = 1.0f;
+    float reachX = playerRadius + arrowRadius;
+    auto laneIt = std::lower_bound(lanesByX.begin(), lanesByX.end(), playerX - reachX - pad,
+                                   [this](int lane, float x) { return lanes[lane].x < x; });
+    
+    // An arrow spans [z - 0.3 length, z + 0.7 length]; it can only overlap
+    // the player in Z if its z lies in [minZ, maxZ]
+    float minZ = playerZ - playerRadius - arrowLength * 0.7f - pad;
+    float maxZ = playerZ + playerRadius + arrowLength * 0.3f + pad;
+    
+    // Exact test for one candidate whose z covered [lowZ, highZ] in the last
+    // step (a single Z for stepped arrows)
+    auto hits = [&](const Arrow& arrow, float lowZ, float highZ) {
+        counters.collisionTests++;
         
         // Check if arrow is within X range of player
         float dx = arrow.x - playerX;
-        if (std::abs(dx) > playerRadius + arrowRadius) continue;
+        if (std::abs(dx) > reachX) return false;
         
         // Check if arrow is within Z range of player (arrow is long)
-        float arrowFront = arrow.z - arrowLength * 0.3f;
-        float arrowBack = arrow.z + arrowLength * 0.7f;
+        float arrowFront = lowZ - arrowLength * 0.3f;
+        float arrowBack = highZ + arrowLength * 0.7f;
         
-        if (playerZ - playerRadius > arrowBack || playerZ + playerRadius < arrowFront) continue;
+        if (playerZ - playerRadius > arrowBack || playerZ + playerRadius < arrowFront) return false;
         
         // Check height collision
         float arrowBottom = arrow.y - arrowRadius;
         float arrowTop = arrow.y + arrowRadius;
         
         // Check if arrow height overlaps with player height
-        if (arrowBottom > playerTop || arrowTop < playerBottom) continue;
+        return !(arrowBottom > playerTop || arrowTop < playerBottom);
+    };
+    
+    for (; laneIt != lanesByX.end() && lanes[*laneIt].x <= playerX + reachX + pad; ++laneIt) {
+        const ArrowLane& lane = lanes[*laneIt];
+        if (lane.empty()) continue;
         
-        // Collision detected!
-        return true;
+        // Lanes are ordered by Z, so the candidates are one contiguous run
+        // from the first arrow at or past the start of the window
+        size_t first = 0, last = lane.size();
+        if (!analytic) {
+            while (first < last) {
+                size_t mid = (first + last) / 2;
+                if (lane[mid].z < minZ) first = mid + 1; else last = mid;
+            }
+            for (size_t i = first; i < lane.size(); i++) {
+                float z = lane[i].z;
+                if (z > maxZ) break;
+                if (hits(lane[i], z, z)) return true;
+            }
+        } else if (lane.mixedSpeeds) {
+            // Each arrow swept its own distance this step, so there is no
+            // single lower bound. These lanes are rare and short: scan them.
+            for (size_t i = 0; i < lane.size(); i++) {
+                float z = getArrowZ(lane[i]);
+                if (z > maxZ) break;
+                if (hits(lane[i], z, getStepStartZ(lane[i]))) return true;
+            }
+        } else {
+            // Analytic arrows are tested over the whole step: one hits if the
+            // Z range it swept since arrowClock - lastStep overlaps the player,
+            // so a hit doesn't depend on the step length. That range overlaps
+            // [minZ, maxZ] for a window of spawn times, and the lane is in
+            // spawn order: find it without computing any positions.
+            float speed = lane[0].speed;
+            float spawnZ = lane[0].spawnZ;
+            double earliest = arrowClock - lastStep - (spawnZ - minZ) / speed;
+            double latest = arrowClock - (spawnZ - maxZ) / speed;
+            while (first < last) {
+                size_t mid = (first + last) / 2;
+                if (lane[mid].spawnTime < earliest) first = mid + 1; else last = mid;
+            }
+            for (size_t i = first; i < lane.size() && lane[i].spawnTime <= latest; i++) {
+                if (hits(lane[i], getArrowZ(lane[i]), getStepStartZ(lane[i]))) return true;
+            }
+        }
     }
     
     return false;
 }
 
-void ProjectileManager::setDifficulty(float speedMultiplier, float spawnRateMultiplier) {
-    // Adjust all launcher parameters based on base values
-    // We need to store base values, so let's recalculate from default
-    float baseIntervals[] = {2.0f, 1.8f, 1.5f, 1.2f, 2.5f, 2.5f, 1.0f, 1.5f, 2.0f, 2.0f, 0.8f, 0.8f};
-    float baseSpeeds[] = {500.0f, 550.0f, 600.0f, 650.0f, 500.0f, 500.0f, 700.0f, 600.0f, 550.0f, 550.0f, 750.0f, 750.0f};
+void ProjectileManager::generateLaunchers(int count) {
+    // Spread along the whole course, with heights, rates and speeds in the
+    // ranges of the hand-placed launchers
+    float launcherZ = 100.0f;
+    launchers.clear();
+    for (int i = 0; i < count; i++) {
+        float x = randomFloat(-200.0f, 2600.0f);
+        float height = randomFloat(30.0f, 100.0f);
+        float interval = randomFloat(0.3f, 2.5f);
+        float speed = randomFloat(500.0f, 750.0f);
+        launchers.push_back(ArrowLauncher(x, height, launcherZ, height, interval, speed));
+    }
     
-    for (size_t i = 0; i < launchers.size() && i < 12; i++) {
+    buildLanes();
+    reset();
+}
+
+void ProjectileManager::setDifficulty(float speedMultiplier, float spawnRateMultiplier) {
+    for (size_t i = 0; i < launchers.size(); i++) {
         // Scale fire interval (lower = faster)
-        launchers[i].fireInterval = baseIntervals[i] / spawnRateMultiplier;
+        launchers[i].fireInterval = launchers[i].baseInterval / spawnRateMultiplier;
         if (launchers[i].fireInterval < 0.3f) launchers[i].fireInterval = 0.3f;
         
         // Scale arrow speed
-        launchers[i].arrowSpeed = baseSpeeds[i] * speedMultiplier;
+        launchers[i].arrowSpeed = launchers[i].baseSpeed * speedMultiplier;
+        
+        // A shot scheduled at the old rate is at most one new interval away
+        double latest = arrowClock + launchers[i].fireInterval;
+        if (launchers[i].nextFireTime > latest) launchers[i].nextFireTime = latest;
+        
+        // Allocate now rather than when the lane fills up mid-run
+        lanes[i].reserve(getLaneCapacity(i));
     }
+    buildFireQueue();
 }
 
 void ProjectileManager::reset() {
-    arrows.clear();
+    for (auto& lane : lanes) {
+        lane.clear();
+        lane.mixedSpeeds = false;
+    }
+    liveArrows = 0;
+    arrowClock = 0.0;
     
-    // Reset all launcher timers
+    // Every launcher fires one interval after the reset
     for (auto& launcher : launchers) {
-        launcher.timer = 0.0f;
+        launcher.nextFireTime = arrowClock + launcher.fireInterval;
     }
+    buildFireQueue();
 }
 
-int ProjectileManager::getActiveArrowCount() const {
-    int count = 0;
-    for (const auto& arrow : arrows) {
-        if (arrow.active) count++;
+void ProjectileManager::hashState(StateHash& hash) const {
+    hash.addBytes(&rngState, sizeof(rngState));
+    hash.addDouble(arrowClock);
+    for (const auto& launcher : launchers) {
+        hash.addDouble(launcher.nextFireTime);
+        hash.addFloat(launcher.fireInterval);
+        hash.addFloat(launcher.arrowSpeed);
     }
-    return count;
+    for (const auto& lane : lanes) {
+        hash.addInt(static_cast<int>(lane.size()));
+        for (size_t i = 0; i < lane.size(); i++) {
+            hash.addFloat(getArrowZ(lane[i]));
+            hash.addFloat(lane[i].speed);
+        }
+    }
+}
+
+int ProjectileManager::getWorkerCount() const {
+    return workerPool ? workerPool->getWorkerCount() : 0;
+}
+
+int ProjectileManager::getActiveArrowCount() const {
+    return static_cast<int>(liveArrows);
 }
@@ -1,15 +1,28 @@
 #ifndef PROJECTILE_H
 #define PROJECTILE_H
 
+#include <cstddef>
 #include <vector>
+#include "Frustum.h"
+#include "LevelOfDetail.h"
+
+class RenderQueue;
+struct RenderState;
+class StateHash;
+class WorkerPool;
 
 struct Arrow {
     float x, y, z;          // Position
+    float prevZ;            // Z at the start of the last simulation step
     float speed;            // Movement speed
     float height;           // Height level (for collision)
-    bool active;            // Is this arrow still flying?
     
-    Arrow() : x(0), y(0), z(0), speed(0), height(30), active(false) {}
+    // Analytic mode: z is never stored, it is spawnZ - speed * (now - spawnTime)
+    double spawnTime;       // arrowClock when it left the launcher
+    float spawnZ;           // Launcher Z it left from
+    
+    Arrow() : x(0), y(0), z(0), prevZ(0), speed(0), height(30),
+              spawnTime(0), spawnZ(0) {}
 };
 
 // Arrow launcher at specific locations
@@ -17,18 +30,78 @@ struct ArrowLauncher {
     float x, y, z;          // Position of launcher
     float targetHeight;     // Height at which arrows fire (low, mid, high)
     float fireInterval;     // Time between shots
-    float timer;            // Current timer
+    double nextFireTime;    // Projectile clock time of the next shot
     float arrowSpeed;       // Speed of arrows from this launcher
+    float baseInterval;     // Interval and speed before difficulty scaling
+    float baseSpeed;
     
     ArrowLauncher(float px, float py, float pz, float height, float interval, float speed)
         : x(px), y(py), z(pz), targetHeight(height), fireInterval(interval), 
-          timer(0), arrowSpeed(speed) {}
+          nextFireTime(interval), arrowSpeed(speed), baseInterval(interval), baseSpeed(speed) {}
+};
+
+// Work done since the last resetCounters(), for throughput reports
+struct ProjectileCounters {
+    long long arrowUpdates;     // Arrows in flight summed over every update
+    long long collisionTests;   // Exact arrow-player tests
+    
+    ProjectileCounters() : arrowUpdates(0), collisionTests(0) {}
+};
+
+// Entry of the launcher schedule: launcher fires at time
+struct FireEvent {
+    double time;
+    int launcher;
+    
+    FireEvent(double t, int index) : time(t), launcher(index) {}
+};
+
+// Arrows of one launcher. They all fly along -Z at the launcher's X,
+// so the lane keeps them ordered by Z (lowest, i.e. oldest, first).
+// Stored as a ring: arrows spawn at the back and retire from the front
+// in O(1), and every slot in [0, size()) is a live arrow.
+struct ArrowLane {
+    float x;
+    bool mixedSpeeds;       // Speeds differ, so arrows can overtake each other
+    
+    explicit ArrowLane(float laneX) : x(laneX), mixedSpeeds(false), head(0), count(0) {}
+    
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return slots.size(); }
+    
+    // i-th oldest arrow (the slot count is a power of two)
+    Arrow& operator[](size_t i) { return slots[(head + i) & (slots.size() - 1)]; }
+    const Arrow& operator[](size_t i) const { return slots[(head + i) & (slots.size() - 1)]; }
+    Arrow& front() { return (*this)[0]; }
+    Arrow& back() { return (*this)[count - 1]; }
+    
+    void reserve(size_t n);             // Grow to at least n slots (allocates)
+    void push(const Arrow& arrow);      // Grows only if the lane is full
+    void popFront();
+    void clear();
+    Arrow* linearize();                 // Move the arrows to one run starting at slot 0
+
+private:
+    std::vector<Arrow> slots;
+    size_t head;            // Slot of the oldest arrow
+    size_t count;
+};
+
+// Work one chunk of lanes did in an update, merged in chunk order afterwards
+struct LanePartition {
+    long long arrowUpdates;     // Arrows in flight in the chunk
+    size_t retired;             // Arrows that left the course
+    
+    LanePartition() : arrowUpdates(0), retired(0) {}
 };
 
 class ProjectileManager {
 private:
-    std::vector<Arrow> arrows;
     std::vector<ArrowLauncher> launchers;
+    std::vector<ArrowLane> lanes;       // lanes[i] holds the arrows of launchers[i]
+    std::vector<int> lanesByX;          // Lane indices sorted by X
+    std::vector<FireEvent> fireQueue;   // Min-heap of every launcher's next shot
     
     float gridHalfSize;         // Half the grid size
     
@@ -36,24 +109,96 @@ private:
     float arrowLength;
     float arrowRadius;
     
-    // Random number generation
+    // Meshes recorded once and drawn instanced, one batch each per render
+    enum MeshKind {
+        LAUNCHER_BODY_MESH,
+        LAUNCHER_STRIPES_MESH,
+        LAUNCHER_LASER_MESH,
+        ARROW_SHAFT_MESH,
+        ARROW_HEAD_MESH,
+        MESH_COUNT
+    };
+    unsigned int meshes[MESH_COUNT];    // 0 until the first render
+    std::vector<float> launcherOffsets; // x, y, z of each launcher drawn
+    std::vector<float> laserOffsets;    // x, y, z of each launcher whose laser is drawn
+    std::vector<float> arrowOffsets;    // x, y, z of each arrow drawn
+    
+    CullStats cullStats;        // Launchers and arrows drawn/skipped in the last render
+    ProjectileCounters counters;
+    
+    // Parallel lane update: each chunk of LANE_CHUNK lanes only touches its
+    // own lanes and its own partition, so threads never share writes
+    static const int LANE_CHUNK = 256;
+    static const size_t PARALLEL_ARROW_THRESHOLD = 4096;  // Fewer arrows update inline
+    WorkerPool* workerPool;     // Created by the first update over the threshold
+    std::vector<LanePartition> partitions;
+    size_t liveArrows;          // Arrows in all lanes
+    float laneStep;             // deltaTime of the update in progress
+    float interpolation;        // Blend between the last two steps for this render
+    
+    // Analytic mode: arrows are only a spawn time, positions come from the clock
+    bool analytic;
+    double arrowClock;          // Simulated seconds since the last reset
+    float lastStep;             // Length of the last update, for interpolation
+    
+    // Random number generation (xorshift32, so a seed replays exactly)
+    unsigned int rngState;
+    unsigned int nextRandom();
     float randomFloat(float min, float max);
     
-    void spawnArrowFromLauncher(ArrowLauncher& launcher);
-    void drawArrow(const Arrow& arrow);
-    void drawLauncher(const ArrowLauncher& launcher);
+    void buildLanes();
+    void buildFireQueue();
+    static bool firesLater(const FireEvent& a, const FireEvent& b);  // Heap order
+    void spawnArrowFromLauncher(size_t launcherIndex, double fireTime, double stepStart);
+    void restoreOrder(ArrowLane& lane);         // Re-sort a lane whose arrows overtook
+    void updateLanes(int begin, int end);       // Move and retire arrows of lanes [begin, end)
+    static void updateLanesTask(void* owner, int begin, int end);  // Worker pool callback
+    size_t getLaneCapacity(size_t launcherIndex) const;  // Most arrows in flight at once
+    float getArrowZ(const Arrow& arrow) const;  // Z at the end of the last step
+    float getStepStartZ(const Arrow& arrow) const;  // Analytic: Z at the start of the last step
+    float getDrawZ(const Arrow& arrow) const;   // Interpolated Z for drawing
+    
+    // Mesh geometry around the origin, recorded by buildMeshes()
+    void drawArrowShaft();
+    void drawArrowHead();       // Head and fletching
+    void drawLauncherBody();
+    void drawLauncherStripes();
+    void drawLauncherLaser();
+    void buildMeshes();         // Needs a current GL context
+    
+    const std::vector<float>& getBatchOffsets(int mesh) const;
+    void submitBatch(RenderQueue& queue, const RenderState& state, int mesh);
+    
+    // Render queue callback: index is the MeshKind to draw
+    static void drawBatchItem(void* owner, int index);
 
 public:
     ProjectileManager(float gridSize);
+    ~ProjectileManager();
     
     void update(float deltaTime);
-    void render();
+    // interpolation places arrows between the last two steps (0 = previous, 1 = current)
+    void render(RenderQueue& queue, const Frustum& frustum, const LevelOfDetail& lod, float interpolation);
     
     // Check collision with player
     // Returns true if player is hit
     bool checkPlayerCollision(float playerX, float playerY, float playerZ, 
                               float playerRadius, float playerHeight, bool isCrouching);
     
+    // Closed-form arrows: no per-arrow work per step, positions exact at any
+    // frame rate. Switching clears the arrows in flight.
+    void setAnalytic(bool enabled);
+    bool isAnalytic() const { return analytic; }
+    
+    // Restart the random sequence (deterministic runs)
+    void setSeed(unsigned int seed);
+    
+    // Fold everything the next step depends on into hash
+    void hashState(StateHash& hash) const;
+    
+    // Replace the course's launchers with count random ones (stress testing)
+    void generateLaunchers(int count);
+    
     // Difficulty scaling
     void setDifficulty(float speedMultiplier, float spawnRateMultiplier);
     
@@ -62,6 +207,13 @@ public:
     
     // Get arrow count for debugging
     int getActiveArrowCount() const;
+    
+    int getLauncherCount() const { return static_cast<int>(launchers.size()); }
+    int getWorkerCount() const;     // Threads sharing the lane update (0 until needed)
+    
+    const CullStats& getCullStats() const { return cullStats; }
+    const ProjectileCounters& getCounters() const { return counters; }
+    void resetCounters() { counters = ProjectileCounters(); }
 };
 
 #endif // PROJECTILE_H
@@ -0,0 +1,128 @@
+#include "RenderQueue.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include "Gfx.h"
+#include <algorithm>
+
+RenderQueue::RenderQueue()
+    : eyeX(0), eyeY(0), eyeZ(0), stateChanges(0), lastItemCount(0) {
+    items.reserve(512);
+    order.reserve(512);
+}
+
+void RenderQueue::begin(float x, float y, float z) {
+    eyeX = x;
+    eyeY = y;
+    eyeZ = z;
+    items.clear();
+}
+
+void RenderQueue::submit(const RenderState& state, float x, float y, float z,
+                         RenderFn draw, void* owner, int index) {
+    float dx = x - eyeX;
+    float dy = y - eyeY;
+    float dz = z - eyeZ;
+    
+    RenderItem item;
+    item.state = state;
+    item.depth = dx * dx + dy * dy + dz * dz;
+    item.draw = draw;
+    item.owner = owner;
+    item.index = index;
+    items.push_back(item);
+}
+
+bool RenderQueue::drawsBefore(const RenderItem& a, const RenderItem& b) const {
+    const RenderState& sa = a.state;
+    const RenderState& sb = b.state;
+    
+    if (sa.layer != sb.layer) return sa.layer < sb.layer;
+    if (sa.blended != sb.blended) return !sa.blended;
+    
+    // Blended: distance first, far to near
+    if (sa.blended && a.depth != b.depth) return a.depth > b.depth;
+    
+    // Group by state so each group needs one setup
+    if (sa.depthTest != sb.depthTest) return sa.depthTest;
+    if (sa.lit != sb.lit) return !sa.lit;
+    if (sa.lines != sb.lines) return !sa.lines;
+    if (sa.lineWidth != sb.lineWidth) return sa.lineWidth < sb.lineWidth;
+    
+    // Opaque: near to far inside a group to save fill rate
+    return a.depth < b.depth;
+}
+
+void RenderQueue::applyState(const RenderState& state, bool force) {
+    if (force || state.lit != current.lit) {
+        if (state.lit) {
+            Gfx::enable(GL_LIGHTING);
+            Gfx::enable(GL_LIGHT0);
+            Gfx::enable(GL_COLOR_MATERIAL);
+            Gfx::colorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
+            Gfx::enable(GL_NORMALIZE);  // Meshes are unit sized and scaled per part
+        } else {
+            Gfx::disable(GL_LIGHTING);
+            Gfx::disable(GL_LIGHT0);
+            Gfx::disable(GL_COLOR_MATERIAL);
+            Gfx::disable(GL_NORMALIZE);
+        }
+        stateChanges++;
+    }
+    
+    if (force || state.blended != current.blended) {
+        if (state.blended) {
+            Gfx::enable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        } else {
+            Gfx::disable(GL_BLEND);
+        }
+        stateChanges++;
+    }
+    
+    if (force || state.depthTest != current.depthTest) {
+        if (state.depthTest) {
+            Gfx::enable(GL_DEPTH_TEST);
+        } else {
+            Gfx::disable(GL_DEPTH_TEST);
+        }
+        stateChanges++;
+    }
+    
+    // Line width only matters for line items
+    float width = state.lines ? state.lineWidth : current.lineWidth;
+    if (force || width != current.lineWidth) {
+        Gfx::lineWidth(width);
+        stateChanges++;
+    }
+    
+    current = state;
+    current.lineWidth = width;
+}
+
+void RenderQueue::flush() {
+    stateChanges = 0;
+    lastItemCount = (int)items.size();
+    
+    order.resize(items.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return drawsBefore(items[a], items[b]);
+    });
+    
+    // Start from a known state, then only change what differs between items
+    applyState(RenderState(), true);
+    stateChanges = 0;
+    for (size_t i : order) {
+        const RenderItem& item = items[i];
+        applyState(item.state, false);
+        item.draw(item.owner, item.index);
+    }
+    applyState(RenderState(), false);
+    
+    items.clear();
+}
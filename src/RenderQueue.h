@@ -0,0 +1,74 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <cstddef>
+#include <vector>
+
+// Pipeline state a draw item needs. The queue sets it up before calling the
+// item, so draw callbacks only emit geometry and colors.
+struct RenderState {
+    int layer;          // Layers draw in increasing order (for order-dependent overlays)
+    bool blended;       // Alpha blending; blended items draw after opaque ones
+    bool depthTest;
+    bool lit;           // Fixed-function lighting with color material
+    bool lines;         // Line primitives (uses lineWidth)
+    float lineWidth;
+    
+    RenderState() : layer(0), blended(false), depthTest(true), lit(false),
+                    lines(false), lineWidth(1.0f) {}
+    
+    static RenderState solid() { return RenderState(); }
+    static RenderState lineState(float width) {
+        RenderState s;
+        s.lines = true;
+        s.lineWidth = width;
+        return s;
+    }
+};
+
+// Draw callback: owner is the submitting object, index picks what to draw
+typedef void (*RenderFn)(void* owner, int index);
+
+// Collects the world's draw items for a frame, then sorts them by state and
+// distance and executes them with as few state changes as possible.
+// Opaque items go front-to-back within a state group; blended items go
+// back-to-front so they composite correctly.
+class RenderQueue {
+private:
+    struct RenderItem {
+        RenderState state;
+        float depth;        // Squared distance to the camera
+        RenderFn draw;
+        void* owner;
+        int index;
+    };
+    
+    std::vector<RenderItem> items;
+    std::vector<size_t> order;
+    float eyeX, eyeY, eyeZ;
+    
+    RenderState current;    // State currently set in GL
+    int stateChanges;       // GL state toggles issued in the last flush
+    int lastItemCount;
+    
+    void applyState(const RenderState& state, bool force);
+    bool drawsBefore(const RenderItem& a, const RenderItem& b) const;
+
+public:
+    RenderQueue();
+    
+    // Start a new frame seen from the given camera position
+    void begin(float eyeX, float eyeY, float eyeZ);
+    
+    // Queue one item; (x, y, z) is its center, used for depth sorting
+    void submit(const RenderState& state, float x, float y, float z,
+                RenderFn draw, void* owner, int index);
+    
+    // Sort and draw everything queued, then restore the default state
+    void flush();
+    
+    int getItemCount() const { return lastItemCount; }
+    int getStateChangeCount() const { return stateChanges; }
+};
+
+#endif // RENDER_QUEUE_H
@@ -0,0 +1,61 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cellSize) : cellSize(cellSize), queryStamp(0) {
+}
+
+int SpatialHash::cellCoord(float v) const {
+    return static_cast<int>(std::floor(v / cellSize));
+}
+
+unsigned long long SpatialHash::cellKey(int cx, int cz) {
+    // Shift the bits as unsigned: shifting a negative signed value is undefined
+    return (static_cast<unsigned long long>(static_cast<unsigned int>(cx)) << 32) |
+           static_cast<unsigned int>(cz);
+}
+
+void SpatialHash::clear() {
+    cells.clear();
+    itemStamps.clear();
+    queryStamp = 0;
+}
+
+void SpatialHash::insert(int index, float minX, float minZ, float maxX, float maxZ) {
+    int x0 = cellCoord(minX), x1 = cellCoord(maxX);
+    int z0 = cellCoord(minZ), z1 = cellCoord(maxZ);
+    for (int cx = x0; cx <= x1; cx++) {
+        for (int cz = z0; cz <= z1; cz++) {
+            cells[cellKey(cx, cz)].push_back(index);
+        }
+    }
+    if (index >= static_cast<int>(itemStamps.size())) {
+        itemStamps.resize(index + 1, 0);
+    }
+}
+
+void SpatialHash::query(float minX, float minZ, float maxX, float maxZ, std::vector<int>& out) const {
+    out.clear();
+    if (cells.empty()) return;
+    
+    // Stamps wrap after 4 billion queries; start over from a clean slate
+    if (++queryStamp == 0) {
+        std::fill(itemStamps.begin(), itemStamps.end(), 0u);
+        queryStamp = 1;
+    }
+    
+    int x0 = cellCoord(minX), x1 = cellCoord(maxX);
+    int z0 = cellCoord(minZ), z1 = cellCoord(maxZ);
+    for (int cx = x0; cx <= x1; cx++) {
+        for (int cz = z0; cz <= z1; cz++) {
+            auto it = cells.find(cellKey(cx, cz));
+            if (it == cells.end()) continue;
+            for (int index : it->second) {
+                if (itemStamps[index] != queryStamp) {
+                    itemStamps[index] = queryStamp;
+                    out.push_back(index);
+                }
+            }
+        }
+    }
+}
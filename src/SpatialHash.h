@@ -0,0 +1,38 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// Uniform hash over the X/Z plane for broadphase queries.
+// Items are inserted once by index with their footprint rectangle;
+// a query returns every item whose cells overlap the query rectangle.
+class SpatialHash {
+private:
+    float cellSize;
+    std::unordered_map<unsigned long long, std::vector<int>> cells;
+    
+    // Per-item stamp so an item spanning several cells is reported once
+    mutable std::vector<unsigned int> itemStamps;
+    mutable unsigned int queryStamp;
+    
+    int cellCoord(float v) const;
+    static unsigned long long cellKey(int cx, int cz);
+
+public:
+    explicit SpatialHash(float cellSize = 64.0f);
+    
+    void clear();
+    void insert(int index, float minX, float minZ, float maxX, float maxZ);
+    
+    // Clears out and fills it with candidate indices (unordered, no duplicates)
+    void query(float minX, float minZ, float maxX, float maxZ, std::vector<int>& out) const;
+    
+    // Identifies the cell containing a point (equal keys = same cell)
+    unsigned long long getCellKey(float x, float z) const { return cellKey(cellCoord(x), cellCoord(z)); }
+    
+    size_t getCellCount() const { return cells.size(); }
+};
+
+#endif // SPATIAL_HASH_H
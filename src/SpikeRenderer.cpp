@@ -0,0 +1,168 @@
+#include "SpikeRenderer.h"
+#include "Frustum.h"
+#include "LevelOfDetail.h"
+#include "RenderQueue.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include "Gfx.h"
+
+SpikeRenderer::SpikeRenderer() : listBase(0), listCount(0) {
+    spikeHeight = 12.0f;
+    spikeSpacing = 10.0f;
+    baseSize = 3.5f;
+    
+    // Pyramid template, generated once: tip plus two base corners per face
+    const float corners[4][2] = {
+        {-baseSize,  baseSize},   // Front-left
+        { baseSize,  baseSize},   // Front-right
+        { baseSize, -baseSize},   // Back-right
+        {-baseSize, -baseSize}    // Back-left
+    };
+    for (int face = 0; face < 4; face++) {
+        const float* a = corners[face];
+        const float* b = corners[(face + 1) % 4];
+        
+        pyramid[face * 3 + 0][0] = 0.0f;
+        pyramid[face * 3 + 0][1] = spikeHeight;
+        pyramid[face * 3 + 0][2] = 0.0f;
+        
+        pyramid[face * 3 + 1][0] = a[0];
+        pyramid[face * 3 + 1][1] = 0.0f;
+        pyramid[face * 3 + 1][2] = a[1];
+        
+        pyramid[face * 3 + 2][0] = b[0];
+        pyramid[face * 3 + 2][1] = 0.0f;
+        pyramid[face * 3 + 2][2] = b[1];
+    }
+}
+
+SpikeRenderer::~SpikeRenderer() {
+    releaseLists();
+}
+
+bool SpikeRenderer::sameGeometry(const Box& a, const Box& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z &&
+           a.width == b.width && a.height == b.height && a.depth == b.depth;
+}
+
+void SpikeRenderer::allocateLists(size_t zoneCount) {
+    releaseLists();
+    if (zoneCount == 0) return;
+    
+    listBase = Gfx::genLists(static_cast<GLsizei>(zoneCount));
+    if (listBase == 0) return;
+    listCount = static_cast<unsigned int>(zoneCount);
+}
+
+void SpikeRenderer::releaseLists() {
+    if (listBase != 0) {
+        Gfx::deleteLists(listBase, static_cast<GLsizei>(listCount));
+        listBase = 0;
+    }
+    listCount = 0;
+    visibleOffsets.clear();
+    batches.clear();
+}
+
+void SpikeRenderer::buildBatch(size_t index, const Box& zone) {
+    Gfx::newList(listBase + static_cast<GLuint>(index), GL_COMPILE);
+    int count = emitSpikes(zone);
+    Gfx::endList();
+    
+    batches[index].source = zone;
+    batches[index].spikeCount = count;
+}
+
+void SpikeRenderer::sync(const std::vector<Box>& zones) {
+    // Zone count changed: the list block has to be reallocated
+    if (zones.size() != batches.size() || (listBase == 0 && !zones.empty())) {
+        allocateLists(zones.size());
+        if (listBase == 0) return;
+        
+        batches.resize(zones.size());
+        for (size_t i = 0; i < zones.size(); i++) {
+            buildBatch(i, zones[i]);
+        }
+        return;
+    }
+    
+    // Otherwise only regenerate the zones whose box moved or resized
+    for (size_t i = 0; i < zones.size(); i++) {
+        if (!sameGeometry(batches[i].source, zones[i])) {
+            buildBatch(i, zones[i]);
+        }
+    }
+}
+
+void SpikeRenderer::render(RenderQueue& queue, const Frustum& frustum, const LevelOfDetail& lod) {
+    if (listBase == 0 || listCount == 0) return;
+    
+    // Spikes stand on top of the zone, so extend its box by the spike height.
+    // Visible zones are queued as one item, sorted at their center.
+    visibleOffsets.clear();
+    float sumX = 0, sumY = 0, sumZ = 0;
+    for (size_t i = 0; i < batches.size(); i++) {
+        const Box& zone = batches[i].source;
+        float minX = zone.x - zone.width / 2, maxX = zone.x + zone.width / 2;
+        float minZ = zone.z - zone.depth / 2, maxZ = zone.z + zone.depth / 2;
+        float topY = zone.y + zone.height;
+        
+        if (!lod.showDecorations(lod.distanceToBox(minX, topY, minZ, maxX, topY + spikeHeight, maxZ))) {
+            continue;
+        }
+        if (frustum.isBoxVisible(minX, topY, minZ, maxX, topY + spikeHeight, maxZ)) {
+            visibleOffsets.push_back(static_cast<unsigned int>(i));
+            sumX += zone.x;
+            sumY += topY + spikeHeight / 2;
+            sumZ += zone.z;
+        }
+    }
+    if (visibleOffsets.empty()) return;
+    
+    float n = static_cast<float>(visibleOffsets.size());
+    queue.submit(RenderState::solid(), sumX / n, sumY / n, sumZ / n,
+                 &SpikeRenderer::drawZonesItem, this, 0);
+}
+
+void SpikeRenderer::drawZonesItem(void* owner, int) {
+    SpikeRenderer* renderer = static_cast<SpikeRenderer*>(owner);
+    Gfx::callLists(renderer->listBase, static_cast<GLsizei>(renderer->visibleOffsets.size()),
+                   renderer->visibleOffsets.data());
+}
+
+int SpikeRenderer::emitSpikes(const Box& zone) {
+    float x1 = zone.x - zone.width / 2;
+    float x2 = zone.x + zone.width / 2;
+    float topY = zone.y + zone.height;
+    float z1 = zone.z - zone.depth / 2;
+    float z2 = zone.z + zone.depth / 2;
+    
+    // Dark metal color for spikes
+    Gfx::color3f(0.25f, 0.25f, 0.28f);
+    
+    // One batch for the whole grid of spikes
+    int count = 0;
+    Gfx::begin(GL_TRIANGLES);
+    for (float sx = x1 + spikeSpacing / 2; sx < x2; sx += spikeSpacing) {
+        for (float sz = z1 + spikeSpacing / 2; sz < z2; sz += spikeSpacing) {
+            for (int v = 0; v < 12; v++) {
+                Gfx::vertex3f(sx + pyramid[v][0], topY + pyramid[v][1], sz + pyramid[v][2]);
+            }
+            count++;
+        }
+    }
+    Gfx::end();
+    
+    return count;
+}
+
+int SpikeRenderer::getSpikeCount() const {
+    int total = 0;
+    for (const auto& batch : batches) {
+        total += batch.spikeCount;
+    }
+    return total;
+}
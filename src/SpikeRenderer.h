@@ -0,0 +1,54 @@
+#ifndef SPIKE_RENDERER_H
+#define SPIKE_RENDERER_H
+
+#include <cstddef>
+#include <vector>
+#include "Obstacle.h"
+
+class Frustum;
+class LevelOfDetail;
+class RenderQueue;
+
+// Draws the spike fields on top of death zones.
+// The pyramid mesh is generated once; each zone gets one pre-baked batch
+// (display list) that is only regenerated when that zone's box changes.
+class SpikeRenderer {
+private:
+    struct ZoneBatch {
+        Box source;             // Box the batch was built from
+        int spikeCount;
+    };
+    
+    std::vector<ZoneBatch> batches;
+    unsigned int listBase;                  // Contiguous block, one list per zone
+    unsigned int listCount;
+    std::vector<unsigned int> visibleOffsets;  // Zones queued this frame, fed to glCallLists
+    
+    float pyramid[12][3];       // Spike template: 4 triangles around the origin
+    float spikeHeight;
+    float spikeSpacing;
+    float baseSize;
+    
+    void allocateLists(size_t zoneCount);
+    void releaseLists();
+    void buildBatch(size_t index, const Box& zone);
+    static bool sameGeometry(const Box& a, const Box& b);
+    static void drawZonesItem(void* owner, int index);  // Render queue callback, all visible zones
+
+public:
+    SpikeRenderer();
+    ~SpikeRenderer();
+    
+    // Rebuild batches for zones that were added or changed since the last sync
+    void sync(const std::vector<Box>& zones);
+    
+    // Queue the spikes of every zone inside the frustum and within decoration distance
+    void render(RenderQueue& queue, const Frustum& frustum, const LevelOfDetail& lod);
+    
+    // Emit the spikes of one zone in a single triangle batch (immediate mode)
+    int emitSpikes(const Box& zone);
+    
+    int getSpikeCount() const;
+};
+
+#endif // SPIKE_RENDERER_H
@@ -0,0 +1,35 @@
+#include "StateHash.h"
+#include <cstring>
+
+StateHash::StateHash() : value(14695981039346656037ULL) {
+}
+
+void StateHash::addBytes(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        value ^= bytes[i];
+        value *= 1099511628211ULL;
+    }
+}
+
+void StateHash::addFloat(float v) {
+    // -0.0 and 0.0 compare equal but are different states to replay
+    unsigned int bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    addBytes(&bits, sizeof(bits));
+}
+
+void StateHash::addDouble(double v) {
+    unsigned long long bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    addBytes(&bits, sizeof(bits));
+}
+
+void StateHash::addInt(int v) {
+    addBytes(&v, sizeof(v));
+}
+
+void StateHash::addBool(bool v) {
+    unsigned char b = v ? 1 : 0;
+    addBytes(&b, 1);
+}
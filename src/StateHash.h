@@ -0,0 +1,24 @@
+#ifndef STATE_HASH_H
+#define STATE_HASH_H
+
+#include <cstddef>
+
+// 64-bit FNV-1a over simulation state. Floats are hashed by their bit
+// pattern, so two runs only match if every value is bit-identical.
+class StateHash {
+private:
+    unsigned long long value;
+
+public:
+    StateHash();
+    
+    void addBytes(const void* data, size_t size);
+    void addFloat(float v);
+    void addDouble(double v);
+    void addInt(int v);
+    void addBool(bool v);
+    
+    unsigned long long getValue() const { return value; }
+};
+
+#endif // STATE_HASH_H
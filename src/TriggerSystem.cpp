@@ -0,0 +1,93 @@
+#include "TriggerSystem.h"
+
+TriggerSystem::TriggerSystem()
+    : hash(128.0f), candidateCell(0), candidatesValid(false),
+      onEnter(nullptr), onExit(nullptr), listener(nullptr) {
+}
+
+void TriggerSystem::clear() {
+    resetOverlaps();
+    volumes.clear();
+    insideFlags.clear();
+    hash.clear();
+}
+
+int TriggerSystem::add(TriggerType type, int id, float minX, float minY, float minZ,
+                       float maxX, float maxY, float maxZ) {
+    TriggerVolume volume;
+    volume.type = type;
+    volume.id = id;
+    volume.minX = minX; volume.minY = minY; volume.minZ = minZ;
+    volume.maxX = maxX; volume.maxY = maxY; volume.maxZ = maxZ;
+    
+    int index = static_cast<int>(volumes.size());
+    volumes.push_back(volume);
+    insideFlags.push_back(0);
+    hash.insert(index, minX, minZ, maxX, maxZ);
+    candidatesValid = false;
+    return index;
+}
+
+void TriggerSystem::setListener(TriggerFn enterFn, TriggerFn exitFn, void* owner) {
+    onEnter = enterFn;
+    onExit = exitFn;
+    listener = owner;
+}
+
+void TriggerSystem::update(float x, float y, float z) {
+    exited.clear();
+    entered.clear();
+    
+    // Exits: only volumes the point was inside can be left
+    for (size_t i = 0; i < inside.size(); ) {
+        int index = inside[i];
+        if (volumes[index].contains(x, y, z)) {
+            i++;
+            continue;
+        }
+        insideFlags[index] = 0;
+        inside[i] = inside.back();
+        inside.pop_back();
+        exited.push_back(index);
+    }
+    
+    // Enters: only volumes sharing the point's cell; look them up again
+    // only after crossing into another cell
+    unsigned long long cell = hash.getCellKey(x, z);
+    if (!candidatesValid || cell != candidateCell) {
+        hash.query(x, z, x, z, candidates);
+        candidateCell = cell;
+        candidatesValid = true;
+    }
+    for (int index : candidates) {
+        if (!insideFlags[index] && volumes[index].contains(x, y, z)) {
+            insideFlags[index] = 1;
+            inside.push_back(index);
+            entered.push_back(index);
+        }
+    }
+    
+    // Callbacks may move the player (respawn); the next update sees that
+    if (onExit) {
+        for (int index : exited) onExit(listener, volumes[index]);
+    }
+    if (onEnter) {
+        for (int index : entered) onEnter(listener, volumes[index]);
+    }
+}
+
+void TriggerSystem::resetOverlaps() {
+    for (int index : inside) {
+        insideFlags[index] = 0;
+    }
+    inside.clear();
+    candidates.clear();
+    candidatesValid = false;
+}
+
+bool TriggerSystem::isInside(TriggerType type) const {
+    for (int index : inside) {
+        if (volumes[index].type == type) return true;
+    }
+    return false;
+}
@@ -0,0 +1,71 @@
+#ifndef TRIGGER_SYSTEM_H
+#define TRIGGER_SYSTEM_H
+
+#include <vector>
+#include "SpatialHash.h"
+
+enum class TriggerType {
+    CHECKPOINT,
+    DEATH_ZONE,
+    GOAL
+};
+
+// Axis-aligned volume that reports when the player enters or leaves it
+struct TriggerVolume {
+    TriggerType type;
+    int id;                         // Index within its type (e.g. checkpoint number)
+    float minX, minY, minZ;
+    float maxX, maxY, maxZ;         // Inclusive bounds
+    
+    bool contains(float x, float y, float z) const {
+        return x >= minX && x <= maxX && y >= minY && y <= maxY && z >= minZ && z <= maxZ;
+    }
+};
+
+typedef void (*TriggerFn)(void* owner, const TriggerVolume& volume);
+
+// Tracks which volumes a point (the player) is inside and dispatches
+// enter/exit events as that changes.
+// Each update re-tests only the volumes the point was already inside plus
+// the candidates of its spatial hash cell; the candidate list is kept until
+// the point moves to another cell.
+class TriggerSystem {
+private:
+    std::vector<TriggerVolume> volumes;
+    SpatialHash hash;
+    
+    std::vector<int> inside;            // Volumes containing the point
+    std::vector<char> insideFlags;      // Same, per volume
+    std::vector<int> candidates;        // Volumes in the point's cell
+    unsigned long long candidateCell;
+    bool candidatesValid;
+    
+    // Events collected during update, dispatched after the state is settled
+    std::vector<int> exited;
+    std::vector<int> entered;
+    
+    TriggerFn onEnter;
+    TriggerFn onExit;
+    void* listener;
+
+public:
+    TriggerSystem();
+    
+    void clear();
+    int add(TriggerType type, int id, float minX, float minY, float minZ,
+            float maxX, float maxY, float maxZ);
+    
+    // Either callback may be null
+    void setListener(TriggerFn enterFn, TriggerFn exitFn, void* owner);
+    
+    // Move the tracked point; fires exits, then enters
+    void update(float x, float y, float z);
+    
+    // Forget the current overlaps without firing exits
+    void resetOverlaps();
+    
+    bool isInside(TriggerType type) const;
+    size_t getVolumeCount() const { return volumes.size(); }
+};
+
+#endif // TRIGGER_SYSTEM_H
@@ -1,11 +1,15 @@
 #include "UserInput.h"
 #include "Obstacle.h"
 #include "Grid.h"
+#include "FigureMesh.h"
+#include "RenderQueue.h"
+#include "StateHash.h"
 #ifdef _WIN32
 #define NOMINMAX
 #include <windows.h>
 #endif
 #include <GL/gl.h>
+#include "Gfx.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
@@ -61,6 +65,8 @@ UserInput::UserInput() {
     crouchHeight = 50;
     playerHeight = normalHeight;
     isCrouching = false;
+    crouchLerpStep = 0.0f;
+    crouchLerpFactor = 0.0f;
     collisionRadius = 20;
     deathY = -100;  // Fall below this and respawn
     devMode = false;  // Set via setDevMode()
@@ -85,6 +91,15 @@ UserInput::UserInput() {
     lastCheckpoint = -1;
     checkpointPopupTimer = 0.0f;
     checkpointMessage = "";
+    
+    snapInterpolation();
+}
+
+void UserInput::snapInterpolation() {
+    prevX = renderX = playerX;
+    prevY = renderY = playerY;
+    prevZ = renderZ = playerZ;
+    prevHeight = renderHeight = playerHeight;
 }
 
 Vector3 UserInput::getViewVector() {
@@ -142,20 +157,52 @@ void UserInput::move(bool forward, bool backward, bool left, bool right, Obstacl
         moveZ -= rightV.z * frameSpeed;
     }
     
-    // Try X movement
-    float newX = playerX + moveX;
-    if (!course || !course->checkCollision(newX, playerY, playerZ, collisionRadius)) {
-        playerX = newX;
+    slideMove(course, moveX, moveZ);
+}
+
+float UserInput::sweepFraction(ObstacleCourse* course, float x, float y, float z,
+                               float dx, float dy, float dz) {
+    float t = course->sweepSphere(x, y, z, dx, dy, dz, collisionRadius);
+    if (t >= 1.0f) return 1.0f;
+    
+    // Stop a hair before the contact so the next test starts outside the box
+    const float skin = 0.01f;
+    float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+    return std::max(0.0f, t - skin / length);
+}
+
+void UserInput::slideMove(ObstacleCourse* course, float dx, float dz) {
+    if (!course) {
+        playerX += dx;
+        playerZ += dz;
+        return;
     }
     
-    // Try Z movement  
-    float newZ = playerZ + moveZ;
-    if (!course || !course->checkCollision(playerX, playerY, newZ, collisionRadius)) {
-        playerZ = newZ;
+    // X and Z separately so the player slides along walls. The sweep stops
+    // at the first obstacle on the way, however long the step is, so thin
+    // walls can't be skipped; the overlap test keeps a player who is
+    // already stuck from moving deeper.
+    if (dx != 0.0f) {
+        float newX = playerX + dx * sweepFraction(course, playerX, playerY, playerZ, dx, 0.0f, 0.0f);
+        if (!course->checkCollision(newX, playerY, playerZ, collisionRadius)) {
+            playerX = newX;
+        }
+    }
+    if (dz != 0.0f) {
+        float newZ = playerZ + dz * sweepFraction(course, playerX, playerY, playerZ, 0.0f, 0.0f, dz);
+        if (!course->checkCollision(playerX, playerY, newZ, collisionRadius)) {
+            playerZ = newZ;
+        }
     }
 }
 
-void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course, Grid* grid, float deltaTime) {
+void UserInput::update(ObstacleCourse* course, Grid* grid, float deltaTime) {
+    // Remember where this step starts, for drawing between steps
+    prevX = playerX;
+    prevY = playerY;
+    prevZ = playerZ;
+    prevHeight = playerHeight;
+    
     // Update timer if running
     if (timerRunning) {
         timer += deltaTime;
@@ -166,8 +213,12 @@ void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course
     
     // Smoothly adjust height when crouching
     float targetHeight = isCrouching ? crouchHeight : normalHeight;
-    float lerpFactor = 1.0f - std::pow(1.0f - 0.2f, timeScale);  // Frame-rate independent lerp
-    playerHeight += (targetHeight - playerHeight) * lerpFactor;
+    if (deltaTime != crouchLerpStep) {
+        // Step-length independent lerp; the step is fixed, so this runs once
+        crouchLerpStep = deltaTime;
+        crouchLerpFactor = 1.0f - std::pow(1.0f - 0.2f, timeScale);
+    }
+    playerHeight += (targetHeight - playerHeight) * crouchLerpFactor;
     
     // Wall running logic
     if (wallRunKeyHeld && !grounded && course) {
@@ -196,8 +247,7 @@ void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course
             
             // Move forward along wall
             float wallRunSpeed = SPEED * 1.2f * timeScale;
-            playerX += forwardV.x * wallRunSpeed;
-            playerZ += forwardV.z * wallRunSpeed;
+            slideMove(course, forwardV.x * wallRunSpeed, forwardV.z * wallRunSpeed);
         } else {
             isWallRunning = false;
         }
@@ -247,10 +297,19 @@ void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course
     }
     // else: off grid and no obstacle = floorY stays at -1000 (no floor)
     
-    // Check if hitting ceiling
-    if (yVel > 0 && course && course->checkCollision(playerX, playerY + playerHeight + 5, playerZ, collisionRadius)) {
-        yVel = 0;
-        newY = playerY;
+    // Check if hitting ceiling: sweep the head probe up to where it would be
+    if (yVel > 0 && course) {
+        float probeY = playerY + playerHeight + 5;
+        if (course->checkCollision(playerX, probeY, playerZ, collisionRadius)) {
+            yVel = 0;
+            newY = playerY;
+        } else {
+            float fraction = sweepFraction(course, playerX, probeY, playerZ, 0.0f, newY - playerY, 0.0f);
+            if (fraction < 1.0f) {
+                yVel = 0;
+                newY = playerY + (newY - playerY) * fraction;
+            }
+        }
     }
     
     // Update Y position
@@ -278,8 +337,8 @@ void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course
     bool offGrid = grid && grid->isOutOfBounds(playerX, playerZ);
     
     // Debug output
-    static int frameCount = 0;
-    if (frameCount++ % 60 == 0) {  // Print every 60 frames
+    static int stepCount = 0;
+    if (stepCount++ % 120 == 0) {  // Print about once a second
         std::cout << "PlayerY: " << playerY << " FloorY: " << floorY 
                   << " OffGrid: " << offGrid << " Grounded: " << grounded << std::endl;
     }
@@ -291,27 +350,18 @@ void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course
         respawn(course);
     }
     
-    // Check for death zone (spike plates)
-    if (!devMode && course && course->isOnDeathZone(playerX, playerY, playerZ)) {
-        std::cout << "HIT DEATH ZONE!" << std::endl;
-        respawn(course);
-    }
-    
-    // Check for checkpoint
-    if (course) {
-        int checkpoint = course->isOnCheckpoint(playerX, playerY, playerZ);
-        if (checkpoint != -1 && checkpoint > lastCheckpoint) {
-            lastCheckpoint = checkpoint;
-            checkpointPopupTimer = 2.0f;  // Show popup for 2 seconds
-            checkpointMessage = "Checkpoint " + std::to_string(checkpoint + 1) + " Reached!";
-            std::cout << checkpointMessage << std::endl;
-        }
-    }
-    
     // Update checkpoint popup timer
     if (checkpointPopupTimer > 0) {
         checkpointPopupTimer -= deltaTime;
     }
+}
+
+void UserInput::updateCamera(int windowWidth, int windowHeight, ObstacleCourse* course, float interpolation) {
+    float t = std::max(0.0f, std::min(1.0f, interpolation));
+    renderX = prevX + (playerX - prevX) * t;
+    renderY = prevY + (playerY - prevY) * t;
+    renderZ = prevZ + (playerZ - prevZ) * t;
+    renderHeight = prevHeight + (playerHeight - prevHeight) * t;
     
     // Set up camera - first person if zoomed in close, otherwise third person
     Vector3 viewDir = getViewVector();
@@ -324,9 +374,9 @@ void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course
     
     if (firstPerson) {
         // First person: camera at player eye level
-        cameraX = playerX;
-        cameraY = playerY + playerHeight * 0.4f;  // Eye level (slightly below top of head)
-        cameraZ = playerZ;
+        cameraX = renderX;
+        cameraY = renderY + renderHeight * 0.4f;  // Eye level (slightly below top of head)
+        cameraZ = renderZ;
         
         // Look forward in view direction
         lookAtX = cameraX + viewDir.x * 100.0f;
@@ -334,19 +384,36 @@ void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course
         lookAtZ = cameraZ + viewDir.z * 100.0f;
     } else {
         // Third person: camera behind and above player
-        cameraX = playerX - viewDir.x * cameraDistance;
-        cameraY = playerY + playerHeight * 0.5f - viewDir.y * cameraDistance;
-        cameraZ = playerZ - viewDir.z * cameraDistance;
+        const float wallGap = 5.0f;  // Keep the near plane off the wall
+        
+        // Look at a point above the player's head. Player Y is the top of the
+        // head, which collision keeps clear, so a low ceiling or overhang
+        // lowers the look-at point instead of swallowing it.
+        lookAtX = renderX;
+        lookAtY = renderY + renderHeight * 0.5f;
+        lookAtZ = renderZ;
+        RayHit hit;
+        if (course && course->segmentCast(renderX, renderY, renderZ, lookAtX, lookAtY, lookAtZ, hit)) {
+            lookAtY = std::max(renderY, renderY + (lookAtY - renderY) * hit.t - wallGap);
+        }
+        
+        cameraX = lookAtX - viewDir.x * cameraDistance;
+        cameraY = lookAtY - viewDir.y * cameraDistance;
+        cameraZ = lookAtZ - viewDir.z * cameraDistance;
         
-        // Look at player center
-        lookAtX = playerX;
-        lookAtY = playerY + playerHeight * 0.5f;
-        lookAtZ = playerZ;
+        // Pull the camera in front of the first box between it and the
+        // (now clear) look-at point
+        if (course && course->segmentCast(lookAtX, lookAtY, lookAtZ, cameraX, cameraY, cameraZ, hit)) {
+            float distance = std::max(1.0f, cameraDistance * hit.t - wallGap);
+            cameraX = lookAtX - viewDir.x * distance;
+            cameraY = lookAtY - viewDir.y * distance;
+            cameraZ = lookAtZ - viewDir.z * distance;
+        }
     }
     
     // Set up projection matrix
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+    Gfx::matrixMode(GL_PROJECTION);
+    Gfx::loadIdentity();
     float aspect = static_cast<float>(windowWidth) / static_cast<float>(windowHeight);
     float fovRad = fov * M_PI / 180.0f;
     float nearPlane = 0.1f;
@@ -361,11 +428,11 @@ void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course
         0, 0, (nearPlane + farPlane) * rangeInv, -1,
         0, 0, nearPlane * farPlane * rangeInv * 2.0f, 0
     };
-    glMultMatrixf(matrix);
+    Gfx::multMatrixf(matrix);
     
     // Set up modelview matrix (camera)
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    Gfx::matrixMode(GL_MODELVIEW);
+    Gfx::loadIdentity();
     
     // Look at (camera transformation)
     Vector3 forward(lookAtX - cameraX, lookAtY - cameraY, lookAtZ - cameraZ);
@@ -386,7 +453,11 @@ void UserInput::update(int windowWidth, int windowHeight, ObstacleCourse* course
         forward.x * cameraX + forward.y * cameraY + forward.z * cameraZ,
         1
     };
-    glMultMatrixf(viewMatrix);
+    Gfx::multMatrixf(viewMatrix);
+    
+    // Keep the planes so renderers can skip what the camera can't see
+    frustum.extract(matrix, viewMatrix);
+    lod.update(cameraX, cameraY, cameraZ, renderDistance);
 }
 
 void UserInput::jump() {
@@ -462,6 +533,7 @@ void UserInput::resetPosition() {
     playerZ = spawnZ;
     yVel = 0;
     grounded = false;
+    snapInterpolation();
 }
 
 void UserInput::respawn(ObstacleCourse* course) {
@@ -475,9 +547,45 @@ void UserInput::respawn(ObstacleCourse* course) {
     }
     yVel = 0;
     grounded = false;
+    snapInterpolation();
     deathCount++;  // Increment death counter
 }
 
+void UserInput::reachCheckpoint(int checkpoint) {
+    // Only progress forward; going back to an earlier checkpoint does nothing
+    if (checkpoint > lastCheckpoint) {
+        lastCheckpoint = checkpoint;
+        checkpointPopupTimer = 2.0f;  // Show popup for 2 seconds
+        checkpointMessage = "Checkpoint " + std::to_string(checkpoint + 1) + " Reached!";
+        std::cout << checkpointMessage << std::endl;
+    }
+}
+
+void UserInput::hashState(StateHash& hash) const {
+    hash.addFloat(playerX);
+    hash.addFloat(playerY);
+    hash.addFloat(playerZ);
+    hash.addFloat(spawnX);
+    hash.addFloat(spawnY);
+    hash.addFloat(spawnZ);
+    hash.addFloat(pitch);
+    hash.addFloat(yaw);
+    hash.addFloat(yVel);
+    hash.addInt(remainingJumps);
+    hash.addBool(grounded);
+    hash.addFloat(coyoteTimer);
+    hash.addFloat(playerHeight);
+    hash.addBool(isCrouching);
+    hash.addBool(isWallRunning);
+    hash.addFloat(wallRunTimer);
+    hash.addInt(wallRunSide);
+    hash.addFloat(timer);
+    hash.addBool(timerRunning);
+    hash.addBool(timerFinished);
+    hash.addInt(deathCount);
+    hash.addInt(lastCheckpoint);
+}
+
 void UserInput::toggleTimer() {
     if (!timerFinished) {  // Can only toggle if not finished
         timerRunning = !timerRunning;
@@ -499,224 +607,61 @@ void UserInput::resetStats() {
     checkpointMessage = "";
 }
 
-void UserInput::render() {
+void UserInput::render(RenderQueue& queue) {
+    // The shadow draws over the world without depth testing, so it goes in a
+    // later layer, and the figure in one after that so it stays on top
+    RenderState shadowState;
+    shadowState.layer = 1;
+    shadowState.blended = true;
+    shadowState.depthTest = false;
+    
     // Always draw shadow circle (visible in both first and third person)
-    drawShadow();
+    queue.submit(shadowState, renderX, renderY - renderHeight, renderZ,
+                 &UserInput::drawShadowItem, this, 0);
     
     // Only draw stick figure in third person mode
     if (cameraDistance >= 20.0f) {
-        drawStickFigure();
+        RenderState figureState;
+        figureState.layer = 2;
+        figureState.lit = true;
+        queue.submit(figureState, renderX, renderY - renderHeight * 0.5f, renderZ,
+                     &UserInput::drawStickFigureItem, this, 0);
     }
 }
 
-// Helper function to draw a smooth 3D capsule/limb (cylinder with rounded ends)
-static void drawLimb(float x1, float y1, float z1, float x2, float y2, float z2, float radius, int segments = 12) {
-    float dx = x2 - x1;
-    float dy = y2 - y1;
-    float dz = z2 - z1;
-    float length = std::sqrt(dx*dx + dy*dy + dz*dz);
-    if (length < 0.001f) return;
-    
-    // Normalize direction
-    dx /= length; dy /= length; dz /= length;
-    
-    // Find perpendicular vectors
-    float px, py, pz;
-    if (std::abs(dy) < 0.9f) {
-        px = -dz; py = 0; pz = dx;
-    } else {
-        px = 1; py = 0; pz = 0;
-    }
-    float pl = std::sqrt(px*px + py*py + pz*pz);
-    px /= pl; py /= pl; pz /= pl;
-    
-    // Second perpendicular
-    float qx = dy * pz - dz * py;
-    float qy = dz * px - dx * pz;
-    float qz = dx * py - dy * px;
-    
-    // Draw cylinder body
-    glBegin(GL_QUAD_STRIP);
-    for (int i = 0; i <= segments; i++) {
-        float angle = (i * 2.0f * M_PI) / segments;
-        float c = std::cos(angle);
-        float s = std::sin(angle);
-        
-        float nx = px * c + qx * s;
-        float ny = py * c + qy * s;
-        float nz = pz * c + qz * s;
-        
-        glNormal3f(nx, ny, nz);
-        glVertex3f(x1 + nx * radius, y1 + ny * radius, z1 + nz * radius);
-        glVertex3f(x2 + nx * radius, y2 + ny * radius, z2 + nz * radius);
-    }
-    glEnd();
-    
-    // Draw hemispherical caps for smooth ends
-    int capSegs = 6;
-    // Cap at start (x1, y1, z1)
-    for (int i = 0; i < capSegs; i++) {
-        float lat0 = M_PI * 0.5f * (float)i / capSegs;
-        float lat1 = M_PI * 0.5f * (float)(i + 1) / capSegs;
-        
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= segments; j++) {
-            float lng = 2 * M_PI * (float)j / segments;
-            float cx = std::cos(lng);
-            float cz = std::sin(lng);
-            
-            for (int k = 0; k < 2; k++) {
-                float lat = (k == 0) ? lat0 : lat1;
-                float r = std::cos(lat) * radius;
-                float offset = -std::sin(lat) * radius;
-                
-                float nx = px * cx * std::cos(lat) + qx * cz * std::cos(lat) - dx * std::sin(lat);
-                float ny = py * cx * std::cos(lat) + qy * cz * std::cos(lat) - dy * std::sin(lat);
-                float nz = pz * cx * std::cos(lat) + qz * cz * std::cos(lat) - dz * std::sin(lat);
-                
-                glNormal3f(nx, ny, nz);
-                glVertex3f(x1 + (px * cx + qx * cz) * r + dx * offset,
-                          y1 + (py * cx + qy * cz) * r + dy * offset,
-                          z1 + (pz * cx + qz * cz) * r + dz * offset);
-            }
-        }
-        glEnd();
-    }
-    
-    // Cap at end (x2, y2, z2)
-    for (int i = 0; i < capSegs; i++) {
-        float lat0 = M_PI * 0.5f * (float)i / capSegs;
-        float lat1 = M_PI * 0.5f * (float)(i + 1) / capSegs;
-        
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= segments; j++) {
-            float lng = 2 * M_PI * (float)j / segments;
-            float cx = std::cos(lng);
-            float cz = std::sin(lng);
-            
-            for (int k = 0; k < 2; k++) {
-                float lat = (k == 0) ? lat0 : lat1;
-                float r = std::cos(lat) * radius;
-                float offset = std::sin(lat) * radius;
-                
-                float nx = px * cx * std::cos(lat) + qx * cz * std::cos(lat) + dx * std::sin(lat);
-                float ny = py * cx * std::cos(lat) + qy * cz * std::cos(lat) + dy * std::sin(lat);
-                float nz = pz * cx * std::cos(lat) + qz * cz * std::cos(lat) + dz * std::sin(lat);
-                
-                glNormal3f(nx, ny, nz);
-                glVertex3f(x2 + (px * cx + qx * cz) * r + dx * offset,
-                          y2 + (py * cx + qy * cz) * r + dy * offset,
-                          z2 + (pz * cx + qz * cz) * r + dz * offset);
-            }
-        }
-        glEnd();
-    }
+void UserInput::drawStickFigureItem(void* owner, int index) {
+    (void)index;
+    static_cast<UserInput*>(owner)->drawStickFigure();
 }
 
-// Helper function to draw a smooth 3D sphere
-static void drawSphere(float x, float y, float z, float radius, int segments = 12) {
-    for (int i = 0; i < segments; i++) {
-        float lat0 = M_PI * (-0.5f + (float)i / segments);
-        float lat1 = M_PI * (-0.5f + (float)(i + 1) / segments);
-        float y0 = std::sin(lat0);
-        float y1 = std::sin(lat1);
-        float r0 = std::cos(lat0);
-        float r1 = std::cos(lat1);
-        
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= segments; j++) {
-            float lng = 2 * M_PI * (float)j / segments;
-            float cx = std::cos(lng);
-            float cz = std::sin(lng);
-            
-            glNormal3f(cx * r0, y0, cz * r0);
-            glVertex3f(x + radius * cx * r0, y + radius * y0, z + radius * cz * r0);
-            glNormal3f(cx * r1, y1, cz * r1);
-            glVertex3f(x + radius * cx * r1, y + radius * y1, z + radius * cz * r1);
-        }
-        glEnd();
-    }
-}
-
-// Draw smooth tapered torso with rounded top
-static void drawTorso(float x, float bottomY, float topY, float bottomRadius, float topRadius, int segments = 12) {
-    float height = topY - bottomY;
-    int rings = 8;
-    
-    for (int i = 0; i < rings; i++) {
-        float t0 = (float)i / rings;
-        float t1 = (float)(i + 1) / rings;
-        float y0 = bottomY + height * t0;
-        float y1 = bottomY + height * t1;
-        float r0 = bottomRadius + (topRadius - bottomRadius) * t0;
-        float r1 = bottomRadius + (topRadius - bottomRadius) * t1;
-        
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= segments; j++) {
-            float angle = 2 * M_PI * (float)j / segments;
-            float cx = std::cos(angle);
-            float cz = std::sin(angle);
-            
-            glNormal3f(cx, 0.1f, cz);
-            glVertex3f(x + cx * r0, y0, cz * r0);
-            glVertex3f(x + cx * r1, y1, cz * r1);
-        }
-        glEnd();
-    }
-    
-    // Rounded dome cap on top
-    int capSegs = 6;
-    float capHeight = topRadius * 0.4f; // How much the dome rises
-    for (int i = 0; i < capSegs; i++) {
-        float lat0 = M_PI * 0.5f * (float)i / capSegs;
-        float lat1 = M_PI * 0.5f * (float)(i + 1) / capSegs;
-        
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= segments; j++) {
-            float angle = 2 * M_PI * (float)j / segments;
-            float cx = std::cos(angle);
-            float cz = std::sin(angle);
-            
-            for (int k = 0; k < 2; k++) {
-                float lat = (k == 0) ? lat0 : lat1;
-                float r = std::cos(lat) * topRadius;
-                float yOffset = std::sin(lat) * capHeight;
-                
-                glNormal3f(cx * std::cos(lat), std::sin(lat), cz * std::cos(lat));
-                glVertex3f(x + cx * r, topY + yOffset, cz * r);
-            }
-        }
-        glEnd();
-    }
+void UserInput::drawShadowItem(void* owner, int index) {
+    (void)index;
+    static_cast<UserInput*>(owner)->drawShadow();
 }
 
 void UserInput::drawStickFigure() {
-    glPushMatrix();
+    Gfx::pushMatrix();
     
     // Position at player location
-    glTranslatef(playerX, playerY - playerHeight, playerZ);
+    Gfx::translatef(renderX, renderY - renderHeight, renderZ);
     
     // Rotate to face camera direction
     float faceAngle = std::atan2(-getViewVector().x, -getViewVector().z) * 180.0f / M_PI;
-    glRotatef(faceAngle, 0, 1, 0);
+    Gfx::rotatef(faceAngle, 0, 1, 0);
     
-    // Enable smooth shading and lighting
-    glShadeModel(GL_SMOOTH);
-    glEnable(GL_LIGHTING);
-    glEnable(GL_LIGHT0);
-    glEnable(GL_COLOR_MATERIAL);
-    glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
+    // Smooth shading; lighting itself is enabled by the render queue
+    Gfx::shadeModel(GL_SMOOTH);
     
     // Soft lighting
     float lightPos[] = {50.0f, 150.0f, 100.0f, 0.0f};
     float lightAmb[] = {0.4f, 0.4f, 0.4f, 1.0f};
     float lightDif[] = {0.6f, 0.6f, 0.6f, 1.0f};
-    glLightfv(GL_LIGHT0, GL_POSITION, lightPos);
-    glLightfv(GL_LIGHT0, GL_AMBIENT, lightAmb);
-    glLightfv(GL_LIGHT0, GL_DIFFUSE, lightDif);
+    Gfx::lightfv(GL_LIGHT0, GL_POSITION, lightPos);
+    Gfx::lightfv(GL_LIGHT0, GL_AMBIENT, lightAmb);
+    Gfx::lightfv(GL_LIGHT0, GL_DIFFUSE, lightDif);
     
     // Body proportions
-    float scale = playerHeight / 70.0f;
+    float scale = renderHeight / 70.0f;
     float legLength = 32.0f * scale;
     float torsoLength = 28.0f * scale;
     float headRadius = 7.0f * scale;
@@ -729,7 +674,11 @@ void UserInput::drawStickFigure() {
     float hipWidth = 4.0f * scale;
     
     // Single smooth color - warm gray
-    glColor3f(0.75f, 0.72f, 0.70f);
+    Gfx::color3f(0.75f, 0.72f, 0.70f);
+    
+    // Coarser meshes the further the camera is from the figure
+    float figureDistance = lod.distanceTo(renderX, renderY - renderHeight * 0.5f, renderZ);
+    FigureMesh::setDetailDrop(lod.figureTierDrop(figureDistance));
     
     // ===== LEGS (smooth, continuous) =====
     float footY = 2.0f * scale;
@@ -737,24 +686,24 @@ void UserInput::drawStickFigure() {
     float hipY = legLength;
     
     // Left leg - thigh and calf as one smooth limb each
-    drawLimb(-hipWidth, footY, 2.0f * scale, -hipWidth * 0.8f, kneeY, 0, legRadius);
-    drawLimb(-hipWidth * 0.8f, kneeY, 0, -hipWidth * 0.5f, hipY, 0, legRadius * 1.1f);
+    FigureMesh::drawLimb(-hipWidth, footY, 2.0f * scale, -hipWidth * 0.8f, kneeY, 0, legRadius);
+    FigureMesh::drawLimb(-hipWidth * 0.8f, kneeY, 0, -hipWidth * 0.5f, hipY, 0, legRadius * 1.1f);
     
     // Right leg
-    drawLimb(hipWidth, footY, 2.0f * scale, hipWidth * 0.8f, kneeY, 0, legRadius);
-    drawLimb(hipWidth * 0.8f, kneeY, 0, hipWidth * 0.5f, hipY, 0, legRadius * 1.1f);
+    FigureMesh::drawLimb(hipWidth, footY, 2.0f * scale, hipWidth * 0.8f, kneeY, 0, legRadius);
+    FigureMesh::drawLimb(hipWidth * 0.8f, kneeY, 0, hipWidth * 0.5f, hipY, 0, legRadius * 1.1f);
     
     // Feet (rounded)
-    drawSphere(-hipWidth, footY, 3.0f * scale, legRadius * 1.3f, 8);
-    drawSphere(hipWidth, footY, 3.0f * scale, legRadius * 1.3f, 8);
+    FigureMesh::drawSphere(-hipWidth, footY, 3.0f * scale, legRadius * 1.3f, 8);
+    FigureMesh::drawSphere(hipWidth, footY, 3.0f * scale, legRadius * 1.3f, 8);
     
     // ===== TORSO (smooth tapered) =====
     float torsoBottom = hipY - 2.0f * scale;
     float torsoTop = hipY + torsoLength;
-    drawTorso(0, torsoBottom, torsoTop, torsoRadiusBottom, torsoRadiusTop);
+    FigureMesh::drawTorso(0, torsoBottom, torsoTop, torsoRadiusBottom, torsoRadiusTop);
     
     // Hip area - smooth sphere to blend legs into torso
-    drawSphere(0, torsoBottom + 2.0f * scale, 0, torsoRadiusBottom * 1.1f, 10);
+    FigureMesh::drawSphere(0, torsoBottom + 2.0f * scale, 0, torsoRadiusBottom * 1.1f, 10);
     
     // ===== ARMS (hanging naturally at sides) =====
     float shoulderY = torsoTop - 4.0f * scale;
@@ -762,82 +711,59 @@ void UserInput::drawStickFigure() {
     float handY = shoulderY - armLength * 0.95f;
     
     // Left arm - slight natural bend
-    drawLimb(-shoulderWidth, shoulderY, 0, 
+    FigureMesh::drawLimb(-shoulderWidth, shoulderY, 0, 
              -shoulderWidth - 2.0f * scale, elbowY, 3.0f * scale, armRadius);
-    drawLimb(-shoulderWidth - 2.0f * scale, elbowY, 3.0f * scale,
+    FigureMesh::drawLimb(-shoulderWidth - 2.0f * scale, elbowY, 3.0f * scale,
              -shoulderWidth - 1.0f * scale, handY, 5.0f * scale, armRadius * 0.9f);
     
     // Right arm
-    drawLimb(shoulderWidth, shoulderY, 0,
+    FigureMesh::drawLimb(shoulderWidth, shoulderY, 0,
              shoulderWidth + 2.0f * scale, elbowY, 3.0f * scale, armRadius);
-    drawLimb(shoulderWidth + 2.0f * scale, elbowY, 3.0f * scale,
+    FigureMesh::drawLimb(shoulderWidth + 2.0f * scale, elbowY, 3.0f * scale,
              shoulderWidth + 1.0f * scale, handY, 5.0f * scale, armRadius * 0.9f);
     
     // Hands (smooth spheres)
-    drawSphere(-shoulderWidth - 1.0f * scale, handY, 5.0f * scale, armRadius * 1.4f, 8);
-    drawSphere(shoulderWidth + 1.0f * scale, handY, 5.0f * scale, armRadius * 1.4f, 8);
+    FigureMesh::drawSphere(-shoulderWidth - 1.0f * scale, handY, 5.0f * scale, armRadius * 1.4f, 8);
+    FigureMesh::drawSphere(shoulderWidth + 1.0f * scale, handY, 5.0f * scale, armRadius * 1.4f, 8);
     
     // Shoulder spheres - larger and positioned to bridge arm and torso
     float shoulderSphereRadius = armRadius * 2.2f;
-    drawSphere(-shoulderWidth + 2.0f * scale, shoulderY + 0.5f * scale, 0, shoulderSphereRadius, 10);
-    drawSphere(shoulderWidth - 2.0f * scale, shoulderY + 0.5f * scale, 0, shoulderSphereRadius, 10);
+    FigureMesh::drawSphere(-shoulderWidth + 2.0f * scale, shoulderY + 0.5f * scale, 0, shoulderSphereRadius, 10);
+    FigureMesh::drawSphere(shoulderWidth - 2.0f * scale, shoulderY + 0.5f * scale, 0, shoulderSphereRadius, 10);
     
     // ===== NECK & HEAD =====
     float neckY = torsoTop;
     float neckTopY = torsoTop + 5.0f * scale;
-    drawLimb(0, neckY, 0, 0, neckTopY, 0, armRadius * 1.0f);
+    FigureMesh::drawLimb(0, neckY, 0, 0, neckTopY, 0, armRadius * 1.0f);
     
     // Head (smooth sphere)
     float headY = neckTopY + headRadius * 0.7f;
-    drawSphere(0, headY, 0, headRadius, 16);
-    
-    // Disable lighting
-    glDisable(GL_LIGHTING);
-    glDisable(GL_LIGHT0);
-    glDisable(GL_COLOR_MATERIAL);
+    FigureMesh::drawSphere(0, headY, 0, headRadius, 16);
+    FigureMesh::setDetailDrop(0);
     
-    glPopMatrix();
+    Gfx::popMatrix();
 }
 
 void UserInput::drawShadow() {
-    glPushMatrix();
+    Gfx::pushMatrix();
     
     // Position shadow at player's feet, raised above ground to avoid z-fighting
-    glTranslatef(playerX, playerY - playerHeight + 2.0f, playerZ);
+    Gfx::translatef(renderX, renderY - renderHeight + 2.0f, renderZ);
     
     // Rotate to lay flat on ground (rotate around X axis)
-    glRotatef(90.0f, 1, 0, 0);
+    Gfx::rotatef(90.0f, 1, 0, 0);
     
-    // Disable depth test to ensure shadow always renders on top of ground
-    glDisable(GL_DEPTH_TEST);
-    
-    // Enable blending for semi-transparent shadow
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // The render queue draws this blended with depth test off,
+    // so the shadow always renders on top of the ground
     
     // Outer shadow - collision radius (lighter)
-    glColor4f(0.0f, 0.0f, 0.0f, 0.3f);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3f(0, 0, 0);  // Center
-    for (int i = 0; i <= 32; i++) {
-        float angle = (i * 2.0f * M_PI) / 32.0f;
-        glVertex3f(std::cos(angle) * collisionRadius, std::sin(angle) * collisionRadius, 0);
-    }
-    glEnd();
+    Gfx::color4f(0.0f, 0.0f, 0.0f, 0.3f);
+    FigureMesh::drawDisc(collisionRadius);
     
     // Inner circle - actual standing point (darker, smaller)
     float standingRadius = 5.0f;  // Small radius where player actually stands
-    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3f(0, 0, 0.1f);  // Slightly above to render on top
-    for (int i = 0; i <= 32; i++) {
-        float angle = (i * 2.0f * M_PI) / 32.0f;
-        glVertex3f(std::cos(angle) * standingRadius, std::sin(angle) * standingRadius, 0.1f);
-    }
-    glEnd();
-    
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
+    Gfx::color4f(0.0f, 0.0f, 0.0f, 0.7f);
+    FigureMesh::drawDisc(standingRadius, 0.1f);  // Slightly above to render on top
     
-    glPopMatrix();
+    Gfx::popMatrix();
 }
@@ -2,6 +2,8 @@
 #define USERINPUT_H
 
 #include <string>
+#include "Frustum.h"
+#include "LevelOfDetail.h"
 
 struct Vector3 {
     float x, y, z;
@@ -15,10 +17,18 @@ struct Vector3 {
 };
 
 class ObstacleCourse;  // Forward declaration
+class RenderQueue;
+class StateHash;
 
 class UserInput {
 private:
     float playerX, playerY, playerZ;  // Player position
+    
+    // Fixed-step interpolation: state at the start of the last tick, and the
+    // blend of both that the camera and figure are drawn at this frame
+    float prevX, prevY, prevZ, prevHeight;
+    float renderX, renderY, renderZ, renderHeight;
+    
     float spawnX, spawnY, spawnZ;     // Respawn position
     float pitch;
     float yaw;
@@ -36,12 +46,16 @@ private:
     float crouchHeight;
     float normalHeight;
     bool isCrouching;
+    float crouchLerpStep;           // Step length crouchLerpFactor was computed for
+    float crouchLerpFactor;         // Height blend per step while (un)crouching
     float collisionRadius;
     float deathY;                   // Y level where player respawns
     bool devMode;                   // God mode - cannot die
     float renderDistance;           // Camera far plane distance
     float sensitivity;              // Mouse sensitivity
     float fov;                      // Field of view in degrees
+    Frustum frustum;                // Camera frustum from the last update, for culling
+    LevelOfDetail lod;              // Detail tiers for the current camera position
     
     // Wall running
     bool isWallRunning;
@@ -62,20 +76,32 @@ private:
     std::string checkpointMessage;  // Message to show
 
     Vector3 getViewVector();
+    void snapInterpolation();       // Drop the previous state (after teleporting)
+    float sweepFraction(ObstacleCourse* course, float x, float y, float z,
+                        float dx, float dy, float dz);  // Safe part of a move (0..1)
+    void slideMove(ObstacleCourse* course, float dx, float dz);
     void drawStickFigure();
     void drawShadow();
+    
+    // Render queue callbacks
+    static void drawStickFigureItem(void* owner, int index);
+    static void drawShadowItem(void* owner, int index);
 
 public:
     UserInput();
     void rotate(float dx, float dy);
     void move(bool forward, bool backward, bool left, bool right, ObstacleCourse* course, float deltaTime);
-    void update(int windowWidth, int windowHeight, ObstacleCourse* course, class Grid* grid, float deltaTime);
-    void render();
+    void update(ObstacleCourse* course, class Grid* grid, float deltaTime);  // One simulation step
+    // Place the camera between the last two steps (0 = previous, 1 = current),
+    // kept in front of any wall between it and the player
+    void updateCamera(int windowWidth, int windowHeight, ObstacleCourse* course, float interpolation);
+    void render(RenderQueue& queue);
     void jump();
     void land();
     void crouchJump();              // Jump while crouching (lower but faster)
     void setCrouch(bool crouch);
     void setWallRunKey(bool held);  // Set wall run key state
+    bool getWallRunKey() const { return wallRunKeyHeld; }
     void adjustCameraDistance(float delta);
     void setPhysics(float speed, float grav, float jump);
     void setDevMode(bool enabled) { devMode = enabled; }
@@ -87,6 +113,8 @@ public:
     void resetPosition();
     void resetStats();              // Reset timer and death count
     void respawn(ObstacleCourse* course = nullptr);  // Respawn and increment death count
+    void reachCheckpoint(int checkpoint);  // Make it the respawn point if it's further along
+    void hashState(StateHash& hash) const;  // Fold the simulated player state into hash
     float getPlayerX() const { return playerX; }
     float getPlayerY() const { return playerY; }
     float getPlayerZ() const { return playerZ; }
@@ -100,6 +128,8 @@ public:
     float getCheckpointPopupTimer() const { return checkpointPopupTimer; }
     const std::string& getCheckpointMessage() const { return checkpointMessage; }
     bool getIsWallRunning() const { return isWallRunning; }
+    const Frustum& getFrustum() const { return frustum; }
+    const LevelOfDetail& getLevelOfDetail() const { return lod; }
 };
 
 #endif // USERINPUT_H
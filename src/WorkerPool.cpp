@@ -0,0 +1,86 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int workerCount)
+    : jobFn(nullptr), jobOwner(nullptr), jobCount(0), jobChunk(1), jobChunks(0),
+      nextChunk(0), generation(0), busyWorkers(0), stopping(false) {
+    if (workerCount < 0) {
+        // The calling thread works too, so leave it a core
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = std::max(0, hardware - 1);
+    }
+    for (int i = 0; i < workerCount; i++) {
+        workers.push_back(std::thread(&WorkerPool::workerLoop, this));
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+bool WorkerPool::runNextChunk() {
+    int chunk = nextChunk.fetch_add(1);
+    if (chunk >= jobChunks) return false;
+    
+    int begin = chunk * jobChunk;
+    int end = std::min(begin + jobChunk, jobCount);
+    jobFn(jobOwner, begin, end);
+    return true;
+}
+
+void WorkerPool::workerLoop() {
+    unsigned long long seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+        busyWorkers++;
+        
+        lock.unlock();
+        while (runNextChunk()) {}
+        lock.lock();
+        
+        if (--busyWorkers == 0) idle.notify_all();
+    }
+}
+
+void WorkerPool::run(int count, int chunkSize, RangeFn fn, void* owner) {
+    if (count <= 0) return;
+    if (chunkSize < 1) chunkSize = 1;
+    
+    // Nothing to share: run it here
+    if (workers.empty() || count <= chunkSize) {
+        fn(owner, 0, count);
+        return;
+    }
+    
+    {
+        // A worker still draining the last job could claim a chunk of this one
+        // before it's fully set up, so wait for them to go idle first
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [&] { return busyWorkers == 0; });
+        
+        jobFn = fn;
+        jobOwner = owner;
+        jobCount = count;
+        jobChunk = chunkSize;
+        jobChunks = (count + chunkSize - 1) / chunkSize;
+        nextChunk.store(0);
+        generation++;
+    }
+    wake.notify_all();
+    
+    while (runNextChunk()) {}
+    
+    // Every chunk is claimed; the ones still running belong to busy workers
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [&] { return busyWorkers == 0; });
+}
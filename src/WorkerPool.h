@@ -0,0 +1,50 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads that split a range of work into chunks.
+// run() hands out chunks to the workers and the calling thread, and
+// returns once every chunk is done. Which thread runs a chunk is not
+// fixed, so tasks must only write state owned by their own range.
+class WorkerPool {
+public:
+    // Task over [begin, end); owner is passed through, like render callbacks
+    typedef void (*RangeFn)(void* owner, int begin, int end);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;   // A job was posted, or the pool is stopping
+    std::condition_variable idle;   // The last busy worker finished
+    
+    // Current job, written under the mutex while no worker is busy
+    RangeFn jobFn;
+    void* jobOwner;
+    int jobCount;
+    int jobChunk;
+    int jobChunks;
+    std::atomic<int> nextChunk;
+    unsigned long long generation;  // Bumped for every posted job
+    int busyWorkers;
+    bool stopping;
+    
+    void workerLoop();
+    bool runNextChunk();            // False when no chunk is left to claim
+
+public:
+    // workerCount < 0 uses one worker per extra hardware thread
+    explicit WorkerPool(int workerCount = -1);
+    ~WorkerPool();
+    
+    // Run fn over [0, count) in chunks of chunkSize and wait for all of them
+    void run(int count, int chunkSize, RangeFn fn, void* owner);
+    
+    int getWorkerCount() const { return static_cast<int>(workers.size()); }
+};
+
+#endif // WORKER_POOL_H
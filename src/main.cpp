@@ -8,11 +8,18 @@
 #include <iostream>
 #include <cmath>
 #include <cstring>
+#include <cstdlib>
 #include "Grid.h"
 #include "UserInput.h"
 #include "Obstacle.h"
 #include "menus/Menu.h"
 #include "Projectile.h"
+#include "FigureMesh.h"
+#include "RenderQueue.h"
+#include "Gfx.h"
+#include "BoxSoA.h"
+#include "StateHash.h"
+#include "InputReplay.h"
 
 // Global variables
 Grid* grid = nullptr;
@@ -20,6 +27,7 @@ UserInput* userInput = nullptr;
 ObstacleCourse* obstacles = nullptr;
 Menu* menu = nullptr;
 ProjectileManager* projectiles = nullptr;
+RenderQueue* renderQueue = nullptr;
 bool w = false, a = false, s = false, d = false;
 bool shift = false;
 int windowWidth = 1920;
@@ -35,8 +43,42 @@ bool firstMouse = true;
 double lastFrameTime = 0.0;
 float deltaTime = 0.0f;
 
+// Fixed-step simulation: frame time is collected and spent in whole steps
+const float SIMULATION_STEP = 1.0f / 120.0f;
+float simulationAccumulator = 0.0f;
+
+// Arrows computed in closed form from their spawn time (--analytic-arrows)
+bool analyticArrows = false;
+
+// Deterministic runs (--deterministic [--seed N]): the projectiles are seeded,
+// input is only applied at tick boundaries as one TickInput per tick, and
+// every tick's input and state are folded into a hash chain. --record FILE
+// saves the inputs, --replay FILE plays them back instead of live input.
+bool deterministic = false;
+unsigned int simulationSeed = 1;
+unsigned long long simulationTick = 0;
+unsigned long long stateHashChain = 0;
+const char* recordPath = nullptr;
+const char* replayPath = nullptr;
+InputReplay* inputReplay = nullptr;
+TickInput pendingInput;         // Presses and mouse motion since the last tick
+bool wallRunHeld = false;       // Wall run key, sampled per tick
+bool replayFinished = false;
+
+// Stress runs (--stress N): N random launchers, no respawns on a hit, and a
+// throughput report every second
+int stressLaunchers = 0;
+double stressProjectileTime = 0.0;  // Seconds spent updating and colliding arrows
+
 // Forward declarations
 void setup();
+void simulate(float step);
+TickInput nextTickInput();
+void applyTickInput(const TickInput& input);
+void restartRun();
+void recordStateHash(const TickInput& input);
+void reportStress(double elapsed, long frames);
+void onTriggerEnter(void* owner, const TriggerVolume& volume);
 void draw();
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 void charCallback(GLFWwindow* window, unsigned int codepoint);
@@ -47,12 +89,63 @@ void applyGraphicsSettings(const GraphicsSettings& graphics);
 void toggleFullscreen();
 
 int main(int argc, char* argv[]) {
+    Gfx::Backend backend = Gfx::Backend::LEGACY;
+    
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--dev") == 0) {
             Menu::devModeEnabled = true;
             std::cout << "Dev mode enabled - god mode active" << std::endl;
         }
+        else if (strcmp(argv[i], "--renderer") == 0 && i + 1 < argc) {
+            // --renderer legacy|core
+            i++;
+            if (strcmp(argv[i], "core") == 0) {
+                backend = Gfx::Backend::CORE;
+            } else if (strcmp(argv[i], "legacy") != 0) {
+                std::cerr << "Unknown renderer '" << argv[i] << "', using legacy" << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--analytic-arrows") == 0) {
+            analyticArrows = true;
+            std::cout << "Analytic arrows enabled" << std::endl;
+        }
+        else if (strcmp(argv[i], "--deterministic") == 0) {
+            deterministic = true;
+        }
+        else if (strcmp(argv[i], "--stress") == 0 && i + 1 < argc) {
+            stressLaunchers = atoi(argv[++i]);
+            if (stressLaunchers < 0) stressLaunchers = 0;
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            simulationSeed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+            deterministic = true;
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+            deterministic = true;
+        }
+    }
+    
+    // A replay brings its own seed, arrow mode and stress launchers
+    inputReplay = new InputReplay();
+    if (replayPath) {
+        if (!inputReplay->startPlayback(replayPath, simulationSeed, analyticArrows, stressLaunchers)) {
+            std::cerr << "Cannot read replay '" << replayPath << "'" << std::endl;
+            delete inputReplay;
+            return -1;
+        }
+        std::cout << "Replaying " << replayPath << std::endl;
+    } else if (recordPath) {
+        if (!inputReplay->startRecording(recordPath, simulationSeed, analyticArrows, stressLaunchers)) {
+            std::cerr << "Cannot write replay '" << recordPath << "'" << std::endl;
+            delete inputReplay;
+            return -1;
+        }
+        std::cout << "Recording input to " << recordPath << std::endl;
     }
     
     // Initialize GLFW
@@ -61,14 +154,24 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
-    // Configure GLFW - request legacy OpenGL context
-    // Don't specify version to get default (legacy) context
-    
-    #ifdef __APPLE__
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-    #endif
+    if (backend == Gfx::Backend::CORE) {
+        // Configure GLFW - request an OpenGL 3.3 core profile context
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        #ifdef __APPLE__
+            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        #endif
+    } else {
+        // Configure GLFW - request legacy OpenGL context
+        // Don't specify version to get default (legacy) context
+        
+        #ifdef __APPLE__
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        #endif
+    }
 
     // Get primary monitor for fullscreen
     GLFWmonitor* monitor = glfwGetPrimaryMonitor();
@@ -90,6 +193,13 @@ int main(int argc, char* argv[]) {
 
     glfwMakeContextCurrent(window);
     
+    // Set up the drawing backend for the context we got
+    if (!Gfx::init(backend)) {
+        glfwTerminate();
+        return -1;
+    }
+    std::cout << "Collision kernel: " << BoxSoA::getKernelName() << std::endl;
+    
     glfwSetKeyCallback(window, keyCallback);
     glfwSetCharCallback(window, charCallback);
     glfwSetCursorPosCallback(window, cursorPosCallback);
@@ -110,6 +220,10 @@ int main(int argc, char* argv[]) {
 
     // Initialize time tracking
     lastFrameTime = glfwGetTime();
+    double startTime = lastFrameTime;
+    long frameCount = 0;
+    double stressReportTime = lastFrameTime;
+    long stressFrames = 0;
 
     // Main loop
     while (!glfwWindowShouldClose(window)) {
@@ -118,7 +232,8 @@ int main(int argc, char* argv[]) {
         deltaTime = static_cast<float>(currentTime - lastFrameTime);
         lastFrameTime = currentTime;
         
-        // Clamp delta time to prevent huge jumps (e.g., when window is moved)
+        // Clamp delta time to prevent huge jumps (e.g., when window is moved);
+        // this also caps the simulation at 12 steps per frame
         if (deltaTime > 0.1f) deltaTime = 0.1f;
 
         // Poll events
@@ -150,16 +265,15 @@ int main(int argc, char* argv[]) {
             glfwSetWindowShouldClose(window, true);
         }
         if (menu->shouldRestart) {
-            userInput->resetPosition();
-            userInput->resetStats();  // Reset timer and death count
-            projectiles->reset();
+            // Deterministic runs restart on the next tick, as part of its input
+            if (deterministic) pendingInput.restart = true;
+            else restartRun();
             menu->resetFlags();
         }
         if (menu->shouldResetToStart) {
             // Reset after completion screen
-            userInput->resetPosition();
-            userInput->resetStats();
-            projectiles->reset();
+            if (deterministic) pendingInput.restart = true;
+            else restartRun();
             // Reset input states to prevent residual movement
             w = s = a = d = false;
             shift = false;
@@ -176,14 +290,42 @@ int main(int argc, char* argv[]) {
 
         // Swap buffers
         glfwSwapBuffers(window);
+        frameCount++;
+        
+        if (stressLaunchers > 0) {
+            stressFrames++;
+            double now = glfwGetTime();
+            if (now - stressReportTime >= 1.0) {
+                reportStress(now - stressReportTime, stressFrames);
+                stressReportTime = now;
+                stressFrames = 0;
+            }
+        }
+    }
+    
+    // Average frame time, for comparing renderers on the same machine
+    if (frameCount > 0) {
+        double elapsed = glfwGetTime() - startTime;
+        std::cout << "Average frame time (" << Gfx::getBackendName() << "): "
+                  << (elapsed * 1000.0 / frameCount) << " ms over " << frameCount
+                  << " frames" << std::endl;
+    }
+
+    if (deterministic) {
+        std::cout << "Final state hash after " << simulationTick << " ticks: " << std::hex
+                  << stateHashChain << std::dec << std::endl;
     }
 
     // Cleanup
+    FigureMesh::cleanup();
     delete grid;
     delete userInput;
     delete obstacles;
     delete menu;
     delete projectiles;
+    delete inputReplay;
+    delete renderQueue;
+    Gfx::cleanup();
     glfwTerminate();
 
     return 0;
@@ -193,9 +335,23 @@ void setup() {
     grid = new Grid(40, 20);  // 40 cells * 20 size = 800 total grid size
     userInput = new UserInput();
     obstacles = new ObstacleCourse();
+    obstacles->getTriggers().setListener(&onTriggerEnter, nullptr, nullptr);
     menu = new Menu();
     menu->setWindow(window);
     projectiles = new ProjectileManager(800.0f);  // Match grid size
+    projectiles->setAnalytic(analyticArrows);
+    if (deterministic) {
+        projectiles->setSeed(simulationSeed);
+        std::cout << "Deterministic simulation, seed " << simulationSeed << std::endl;
+    }
+    if (stressLaunchers > 0) {
+        projectiles->generateLaunchers(stressLaunchers);
+        std::cout << "Stress test with " << stressLaunchers << " launchers" << std::endl;
+    }
+    renderQueue = new RenderQueue();
+    
+    // Build the player figure meshes once, now that the GL context exists
+    FigureMesh::init();
     
     // Load saved settings
     menu->loadSettings();
@@ -250,6 +406,180 @@ void toggleFullscreen() {
     glViewport(0, 0, windowWidth, windowHeight);
 }
 
+// Advance the player and projectiles by one fixed step
+void simulate(float step) {
+    if (replayFinished) return;
+    
+    // Held keys and settings as of now. Deterministic runs also take this
+    // tick's presses and mouse motion from it (or the whole of it from the replay).
+    TickInput input = nextTickInput();
+    if (replayFinished) return;
+    if (deterministic) applyTickInput(input);
+    
+    userInput->setCrouch(input.crouch);
+    userInput->update(obstacles, grid, step);
+    userInput->move(input.forward, input.backward, input.left, input.right, obstacles, step);
+    
+    // Update projectiles
+    double projectileStart = (stressLaunchers > 0) ? glfwGetTime() : 0.0;
+    projectiles->update(step);
+    
+    // Check for projectile collision with player (skip if dev mode).
+    // Stress runs check but never respawn, so the load stays up.
+    bool checkHits = !input.devMode || stressLaunchers > 0;
+    if (checkHits && 
+        projectiles->checkPlayerCollision(
+            userInput->getPlayerX(),
+            userInput->getPlayerY(),
+            userInput->getPlayerZ(),
+            userInput->getCollisionRadius(),
+            userInput->getPlayerHeight(),
+            userInput->getIsCrouching()) &&
+        stressLaunchers == 0) {
+        // Player hit! Respawn (counts as death)
+        userInput->respawn(obstacles);
+        projectiles->reset();
+    }
+    if (stressLaunchers > 0) stressProjectileTime += glfwGetTime() - projectileStart;
+    
+    // Checkpoints and the goal report through onTriggerEnter
+    TriggerSystem& triggers = obstacles->getTriggers();
+    triggers.update(userInput->getPlayerX(),
+                    userInput->getPlayerY(),
+                    userInput->getPlayerZ());
+    
+    // Spike plates are checked every step rather than on enter, so turning
+    // dev mode off while standing on one still kills
+    if (!input.devMode && triggers.isInside(TriggerType::DEATH_ZONE)) {
+        std::cout << "HIT DEATH ZONE!" << std::endl;
+        userInput->respawn(obstacles);
+        triggers.resetOverlaps();  // The player was moved away
+    }
+    
+    if (deterministic) recordStateHash(input);
+}
+
+TickInput nextTickInput() {
+    TickInput input;
+    if (inputReplay->isPlaying()) {
+        if (!inputReplay->read(input)) {
+            // Out of input: stop here so the final hash matches the recording
+            std::cout << "Replay finished after " << simulationTick << " ticks" << std::endl;
+            replayFinished = true;
+            glfwSetWindowShouldClose(window, true);
+        }
+        return input;
+    }
+    
+    const GameSettings& settings = menu->getSettings();
+    input.forward = w;
+    input.backward = s;
+    input.left = a;
+    input.right = d;
+    input.crouch = shift;
+    input.wallRun = wallRunHeld;
+    input.devMode = settings.devMode;
+    input.speed = settings.speed;
+    input.gravity = settings.gravity;
+    input.jumpForce = settings.jumpForce;
+    input.sensitivity = settings.controls.sensitivity;
+    
+    // Events queued by the callbacks (only in deterministic runs)
+    input.jump = pendingInput.jump;
+    input.toggleTimer = pendingInput.toggleTimer;
+    input.resetStats = pendingInput.resetStats;
+    input.restart = pendingInput.restart;
+    input.lookX = pendingInput.lookX;
+    input.lookY = pendingInput.lookY;
+    pendingInput = TickInput();
+    
+    inputReplay->write(input);
+    return input;
+}
+
+// Deterministic runs: do at the start of the tick what the callbacks and
+// the per-frame settings update do immediately otherwise
+void applyTickInput(const TickInput& input) {
+    userInput->setPhysics(input.speed, input.gravity, input.jumpForce);
+    userInput->setDevMode(input.devMode);
+    userInput->setSensitivity(input.sensitivity);
+    
+    if (input.restart) restartRun();
+    if (input.lookX != 0.0f || input.lookY != 0.0f) userInput->rotate(input.lookX, input.lookY);
+    if (input.wallRun != userInput->getWallRunKey()) userInput->setWallRunKey(input.wallRun);
+    
+    userInput->setCrouch(input.crouch);
+    if (input.jump) {
+        if (input.crouch && userInput->getIsCrouching()) {
+            userInput->crouchJump();
+        } else {
+            userInput->jump();
+        }
+    }
+    if (input.toggleTimer) userInput->toggleTimer();
+    if (input.resetStats) userInput->resetStats();
+}
+
+// Back to the start with a fresh timer, death count and arrows
+void restartRun() {
+    userInput->resetPosition();
+    userInput->resetStats();
+    projectiles->reset();
+    obstacles->getTriggers().resetOverlaps();  // Re-enter whatever is at the start
+}
+
+// Print projectile throughput over the last elapsed seconds and start over
+void reportStress(double elapsed, long frames) {
+    const ProjectileCounters& counters = projectiles->getCounters();
+    std::cout << "Stress: " << projectiles->getActiveArrowCount() << " arrows, "
+              << projectiles->getWorkerCount() << " worker threads, "
+              << static_cast<long long>(counters.arrowUpdates / elapsed) << " arrow updates/s, "
+              << static_cast<long long>(counters.collisionTests / elapsed) << " collision tests/s, "
+              << (elapsed * 1000.0 / frames) << " ms/frame ("
+              << (stressProjectileTime * 1000.0 / frames) << " ms projectiles)" << std::endl;
+    projectiles->resetCounters();
+    stressProjectileTime = 0.0;
+}
+
+// Chain this tick's input and resulting state onto the previous hash; print
+// it once a second
+void recordStateHash(const TickInput& input) {
+    StateHash hash;
+    hash.addBytes(&stateHashChain, sizeof(stateHashChain));
+    input.hashInto(hash);
+    userInput->hashState(hash);
+    projectiles->hashState(hash);
+    stateHashChain = hash.getValue();
+    simulationTick++;
+    
+    if (simulationTick % 120 == 0) {
+        std::cout << "Tick " << simulationTick << " state hash " << std::hex
+                  << stateHashChain << std::dec << std::endl;
+    }
+}
+
+void onTriggerEnter(void* owner, const TriggerVolume& volume) {
+    (void)owner;  // Globals are used instead
+    
+    switch (volume.type) {
+        case TriggerType::CHECKPOINT:
+            userInput->reachCheckpoint(volume.id);
+            break;
+        case TriggerType::DEATH_ZONE:
+            // Spike plates are polled in simulate (dev mode survives them)
+            break;
+        case TriggerType::GOAL:
+            // Reached the goal (triggers even if the timer isn't running)
+            if (!userInput->isTimerFinished()) {
+                userInput->stopTimer();  // Stop timer at goal
+                // Show completion screen
+                menu->showCompletion(userInput->getTimer(), userInput->getDeathCount());
+                glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+            }
+            break;
+    }
+}
+
 void draw() {
     // Clear screen
     glClearColor(0.1f, 0.15f, 0.2f, 1.0f);
@@ -257,11 +587,6 @@ void draw() {
 
     // Only update game if menu is closed
     if (!menu->isOpen()) {
-        // Update
-        userInput->setCrouch(shift);
-        userInput->update(windowWidth, windowHeight, obstacles, grid, deltaTime);
-        userInput->move(w, s, a, d, obstacles, deltaTime);
-        
         // Apply current physics settings
         const GameSettings& settings = menu->getSettings();
         userInput->setPhysics(settings.speed, settings.gravity, settings.jumpForce);
@@ -270,33 +595,17 @@ void draw() {
         userInput->setSensitivity(settings.controls.sensitivity);
         userInput->setFOV(settings.graphics.fov);
         
-        // Update projectiles
-        projectiles->update(deltaTime);
-        
-        // Check for projectile collision with player (skip if dev mode)
-        if (!menu->getSettings().devMode && 
-            projectiles->checkPlayerCollision(
-                userInput->getPlayerX(),
-                userInput->getPlayerY(),
-                userInput->getPlayerZ(),
-                userInput->getCollisionRadius(),
-                userInput->getPlayerHeight(),
-                userInput->getIsCrouching())) {
-            // Player hit! Respawn (counts as death)
-            userInput->respawn(obstacles);
-            projectiles->reset();
+        // Run as many whole steps as the frame time covers; the rest carries
+        // over. Reaching the goal opens the menu and stops the simulation.
+        simulationAccumulator += deltaTime;
+        while (simulationAccumulator >= SIMULATION_STEP && !menu->isOpen()) {
+            simulate(SIMULATION_STEP);
+            simulationAccumulator -= SIMULATION_STEP;
         }
         
-        // Check if player reached the goal (trigger even if timer not running)
-        if (!userInput->isTimerFinished() && obstacles->isOnGoal(
-                userInput->getPlayerX(),
-                userInput->getPlayerY(),
-                userInput->getPlayerZ())) {
-            userInput->stopTimer();  // Stop timer at goal
-            // Show completion screen
-            menu->showCompletion(userInput->getTimer(), userInput->getDeathCount());
-            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-        }
+        // Draw between the last two steps by how far into the next one we are
+        userInput->updateCamera(windowWidth, windowHeight, obstacles,
+                                simulationAccumulator / SIMULATION_STEP);
     }
     
     // Update completion countdown
@@ -307,11 +616,16 @@ void draw() {
         glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
     }
     
-    // Render game world
-    grid->update();
-    obstacles->render(deltaTime);
-    projectiles->render();
-    userInput->render();
+    // Render game world: every subsystem queues its items, then the queue
+    // draws them sorted by state and distance
+    const Frustum& frustum = userInput->getFrustum();
+    const LevelOfDetail& lod = userInput->getLevelOfDetail();
+    renderQueue->begin(lod.getEyeX(), lod.getEyeY(), lod.getEyeZ());
+    grid->update(*renderQueue, frustum, lod);
+    obstacles->render(*renderQueue, deltaTime, frustum, lod);
+    projectiles->render(*renderQueue, frustum, lod, simulationAccumulator / SIMULATION_STEP);
+    userInput->render(*renderQueue);
+    renderQueue->flush();
     
     // Render checkpoint popup if active
     if (userInput->getCheckpointPopupTimer() > 0) {
@@ -380,18 +694,28 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
         if (key == controls.keyRight) d = true;
         if (key == controls.keyCrouch) {
             shift = true;
-            userInput->setCrouch(true);  // Immediately crouch
+            if (!deterministic) userInput->setCrouch(true);  // Immediately crouch
         }
-        if (key == controls.keyJump) {
-            if (shift && userInput->getIsCrouching()) {
-                userInput->crouchJump();  // Crouch jump when crouching + space
-            } else {
-                userInput->jump();
+        if (key == GLFW_KEY_E) {
+            wallRunHeld = true;
+            if (!deterministic) userInput->setWallRunKey(true);  // Wall run key
+        }
+        if (deterministic) {
+            // Applied at the start of the next tick
+            if (key == controls.keyJump) pendingInput.jump = true;
+            if (key == controls.keyTimer) pendingInput.toggleTimer = true;
+            if (key == controls.keyReset) pendingInput.resetStats = true;
+        } else {
+            if (key == controls.keyJump) {
+                if (shift && userInput->getIsCrouching()) {
+                    userInput->crouchJump();  // Crouch jump when crouching + space
+                } else {
+                    userInput->jump();
+                }
             }
+            if (key == controls.keyTimer) userInput->toggleTimer();
+            if (key == controls.keyReset) userInput->resetStats();
         }
-        if (key == controls.keyTimer) userInput->toggleTimer();
-        if (key == controls.keyReset) userInput->resetStats();
-        if (key == GLFW_KEY_E) userInput->setWallRunKey(true);  // Wall run key
         if (key == controls.keyHelp) {  // Help menu
             menu->open();
             menu->showHelp();
@@ -409,9 +733,12 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
         if (key == controls.keyRight) d = false;
         if (key == controls.keyCrouch) {
             shift = false;
-            userInput->setCrouch(false);  // Immediately uncrouch
+            if (!deterministic) userInput->setCrouch(false);  // Immediately uncrouch
+        }
+        if (key == GLFW_KEY_E) {
+            wallRunHeld = false;
+            if (!deterministic) userInput->setWallRunKey(false);  // Release wall run
         }
-        if (key == GLFW_KEY_E) userInput->setWallRunKey(false);  // Release wall run
     }
 }
 
@@ -443,7 +770,13 @@ void cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
     lastMouseX = xpos;
     lastMouseY = ypos;
 
-    userInput->rotate(dx, dy);
+    if (deterministic) {
+        // Turned at the start of the next tick
+        pendingInput.lookX += dx;
+        pendingInput.lookY += dy;
+    } else {
+        userInput->rotate(dx, dy);
+    }
 }
 
 void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
@@ -5,6 +5,7 @@
 #include <windows.h>
 #endif
 #include <GL/gl.h>
+#include "Gfx.h"
 #include <GLFW/glfw3.h>
 #include <cmath>
 #include <algorithm>
@@ -63,6 +64,9 @@ Menu::Menu() {
     screenHeight = 1080;
     
     fontLoaded = false;
+    fontAtlasTexture = 0;
+    fontAtlasWidth = 0;
+    fontAtlasHeight = 0;
     ftLibrary = nullptr;
     ftFace = nullptr;
     
@@ -240,43 +244,96 @@ bool Menu::initFont(const std::string& fontPath) {
     }
     
     FT_Set_Pixel_Sizes(ftFace, 0, 48);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    
+    // Render every glyph first so the atlas can be sized to fit them
+    const int padding = 2;  // Keeps linear filtering from bleeding between glyphs
+    std::vector<std::vector<unsigned char>> bitmaps(128);
+    for (int i = 0; i < 256; i++) {
+        characters[i].loaded = false;
+    }
+    
+    int rowWidth = 512;
+    int penX = padding, penY = padding, rowHeight = 0;
+    int glyphX[128], glyphY[128];
     
     for (unsigned char c = 0; c < 128; c++) {
         if (FT_Load_Char(ftFace, c, FT_LOAD_RENDER)) continue;
         
-        unsigned int texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA,
-            ftFace->glyph->bitmap.width, ftFace->glyph->bitmap.rows,
-            0, GL_ALPHA, GL_UNSIGNED_BYTE, ftFace->glyph->bitmap.buffer);
+        const FT_Bitmap& bitmap = ftFace->glyph->bitmap;
+        int w = (int)bitmap.width;
+        int h = (int)bitmap.rows;
         
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        // Copy rows out (the FreeType pitch may be wider than the glyph)
+        bitmaps[c].resize(w * h);
+        for (int row = 0; row < h; row++) {
+            memcpy(&bitmaps[c][row * w], bitmap.buffer + row * bitmap.pitch, w);
+        }
+        
+        // Simple shelf packing: fill a row left to right, then start a new one
+        if (penX + w + padding > rowWidth) {
+            penX = padding;
+            penY += rowHeight + padding;
+            rowHeight = 0;
+        }
+        glyphX[c] = penX;
+        glyphY[c] = penY;
+        penX += w + padding;
+        rowHeight = std::max(rowHeight, h);
         
-        Character character = {
-            texture,
-            (int)ftFace->glyph->bitmap.width,
-            (int)ftFace->glyph->bitmap.rows,
-            ftFace->glyph->bitmap_left,
-            ftFace->glyph->bitmap_top,
-            (unsigned int)ftFace->glyph->advance.x
-        };
-        characters[c] = character;
+        Character& character = characters[c];
+        character.loaded = true;
+        character.sizeX = w;
+        character.sizeY = h;
+        character.bearingX = ftFace->glyph->bitmap_left;
+        character.bearingY = ftFace->glyph->bitmap_top;
+        character.advance = (unsigned int)ftFace->glyph->advance.x;
     }
     
+    // Power-of-two height for old drivers
+    int usedHeight = penY + rowHeight + padding;
+    int atlasHeight = 1;
+    while (atlasHeight < usedHeight) atlasHeight *= 2;
+    
+    std::vector<unsigned char> atlas(rowWidth * atlasHeight, 0);
+    for (int c = 0; c < 128; c++) {
+        Character& ch = characters[c];
+        if (!ch.loaded) continue;
+        
+        for (int row = 0; row < ch.sizeY; row++) {
+            memcpy(&atlas[(glyphY[c] + row) * rowWidth + glyphX[c]],
+                   &bitmaps[c][row * ch.sizeX], ch.sizeX);
+        }
+        
+        ch.u0 = (float)glyphX[c] / rowWidth;
+        ch.v0 = (float)glyphY[c] / atlasHeight;
+        ch.u1 = (float)(glyphX[c] + ch.sizeX) / rowWidth;
+        ch.v1 = (float)(glyphY[c] + ch.sizeY) / atlasHeight;
+    }
+    
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glGenTextures(1, &fontAtlasTexture);
+    glBindTexture(GL_TEXTURE_2D, fontAtlasTexture);
+    Gfx::texImageAlpha(rowWidth, atlasHeight, atlas.data());
+    
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    
+    fontAtlasWidth = rowWidth;
+    fontAtlasHeight = atlasHeight;
     fontLoaded = true;
     return true;
 }
 
 void Menu::cleanupFont() {
-    for (auto& pair : characters) {
-        glDeleteTextures(1, &pair.second.textureID);
+    if (fontAtlasTexture) {
+        glDeleteTextures(1, &fontAtlasTexture);
+        fontAtlasTexture = 0;
+    }
+    for (int i = 0; i < 256; i++) {
+        characters[i].loaded = false;
     }
-    characters.clear();
     
     if (ftFace) { FT_Done_Face(ftFace); ftFace = nullptr; }
     if (ftLibrary) { FT_Done_FreeType(ftLibrary); ftLibrary = nullptr; }
@@ -357,75 +414,55 @@ void Menu::applyDifficulty(Difficulty diff) {
 // ==================== Drawing Functions ====================
 
 void Menu::drawText(float x, float y, const std::string& text, float scale) {
-    if (!fontLoaded) return;
+    if (!fontLoaded || text.empty()) return;
     
-    float guiScale = settings.graphics.guiScale;
-    scale *= guiScale;
+    const TextLayout& layout = textLayouts.get(text, scale, settings.graphics.guiScale, characters);
+    if (layout.vertices.empty()) return;
     
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
+    // The atlas is the only texture the game creates, so it stays bound
+    // from initFont() and no per-string bind is needed
+    Gfx::enable(GL_TEXTURE_2D);
+    Gfx::enable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
-    for (char c : text) {
-        if (characters.find(c) == characters.end()) continue;
-        Character& ch = characters[c];
-        
-        float xpos = x + ch.bearingX * scale;
-        float ypos = y - (ch.sizeY - ch.bearingY) * scale;
-        float w = ch.sizeX * scale;
-        float h = ch.sizeY * scale;
-        
-        glBindTexture(GL_TEXTURE_2D, ch.textureID);
-        glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex2f(xpos, ypos + h);
-        glTexCoord2f(1, 0); glVertex2f(xpos + w, ypos + h);
-        glTexCoord2f(1, 1); glVertex2f(xpos + w, ypos);
-        glTexCoord2f(0, 1); glVertex2f(xpos, ypos);
-        glEnd();
-        
-        x += (ch.advance >> 6) * scale;
-    }
+    // Cached quads are relative to the pen origin, so just submit them there
+    Gfx::pushMatrix();
+    Gfx::translatef(x, y, 0.0f);
+    Gfx::drawTexturedQuads2D(&layout.vertices[0], layout.vertexCount());
+    Gfx::popMatrix();
     
-    glDisable(GL_TEXTURE_2D);
+    Gfx::disable(GL_TEXTURE_2D);
 }
 
 float Menu::getTextWidth(const std::string& text, float scale) {
     if (!fontLoaded) return 0;
     
-    float guiScale = settings.graphics.guiScale;
-    scale *= guiScale;
-    
-    float width = 0;
-    for (char c : text) {
-        if (characters.find(c) == characters.end()) continue;
-        width += (characters[c].advance >> 6) * scale;
-    }
-    return width;
+    return textLayouts.get(text, scale, settings.graphics.guiScale, characters).width;
 }
 
 void Menu::drawButton(float x, float y, float width, float height, 
                       const std::string& text, bool selected, bool hovered) {
     if (selected) {
-        glColor4f(0.3f, 0.5f, 0.7f, 0.9f);
+        Gfx::color4f(0.3f, 0.5f, 0.7f, 0.9f);
     } else if (hovered) {
-        glColor4f(0.25f, 0.35f, 0.45f, 0.9f);
+        Gfx::color4f(0.25f, 0.35f, 0.45f, 0.9f);
     } else {
-        glColor4f(0.15f, 0.2f, 0.25f, 0.9f);
+        Gfx::color4f(0.15f, 0.2f, 0.25f, 0.9f);
     }
     
-    glBegin(GL_QUADS);
-    glVertex2f(x, y); glVertex2f(x + width, y);
-    glVertex2f(x + width, y + height); glVertex2f(x, y + height);
-    glEnd();
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(x, y); Gfx::vertex2f(x + width, y);
+    Gfx::vertex2f(x + width, y + height); Gfx::vertex2f(x, y + height);
+    Gfx::end();
     
-    glColor3f(0.5f, 0.6f, 0.7f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(x, y); glVertex2f(x + width, y);
-    glVertex2f(x + width, y + height); glVertex2f(x, y + height);
-    glEnd();
+    Gfx::color3f(0.5f, 0.6f, 0.7f);
+    Gfx::lineWidth(2.0f);
+    Gfx::begin(GL_LINE_LOOP);
+    Gfx::vertex2f(x, y); Gfx::vertex2f(x + width, y);
+    Gfx::vertex2f(x + width, y + height); Gfx::vertex2f(x, y + height);
+    Gfx::end();
     
-    glColor3f(1.0f, 1.0f, 1.0f);
+    Gfx::color3f(1.0f, 1.0f, 1.0f);
     float textW = getTextWidth(text, 0.5f);
     drawText(x + (width - textW) / 2, y + height / 2 - 10, text, 0.5f);
 }
@@ -434,86 +471,86 @@ void Menu::drawCheckbox(float x, float y, float size, const std::string& label,
                         bool checked, bool selected) {
     // Box
     if (selected) {
-        glColor4f(0.3f, 0.5f, 0.7f, 0.9f);
+        Gfx::color4f(0.3f, 0.5f, 0.7f, 0.9f);
     } else {
-        glColor4f(0.15f, 0.2f, 0.25f, 0.9f);
+        Gfx::color4f(0.15f, 0.2f, 0.25f, 0.9f);
     }
-    glBegin(GL_QUADS);
-    glVertex2f(x, y); glVertex2f(x + size, y);
-    glVertex2f(x + size, y + size); glVertex2f(x, y + size);
-    glEnd();
-    
-    glColor3f(0.5f, 0.6f, 0.7f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(x, y); glVertex2f(x + size, y);
-    glVertex2f(x + size, y + size); glVertex2f(x, y + size);
-    glEnd();
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(x, y); Gfx::vertex2f(x + size, y);
+    Gfx::vertex2f(x + size, y + size); Gfx::vertex2f(x, y + size);
+    Gfx::end();
+    
+    Gfx::color3f(0.5f, 0.6f, 0.7f);
+    Gfx::lineWidth(2.0f);
+    Gfx::begin(GL_LINE_LOOP);
+    Gfx::vertex2f(x, y); Gfx::vertex2f(x + size, y);
+    Gfx::vertex2f(x + size, y + size); Gfx::vertex2f(x, y + size);
+    Gfx::end();
     
     // Checkmark
     if (checked) {
-        glColor3f(0.2f, 0.9f, 0.2f);
-        glLineWidth(3.0f);
-        glBegin(GL_LINES);
-        glVertex2f(x + size * 0.2f, y + size * 0.5f);
-        glVertex2f(x + size * 0.4f, y + size * 0.2f);
-        glVertex2f(x + size * 0.4f, y + size * 0.2f);
-        glVertex2f(x + size * 0.8f, y + size * 0.8f);
-        glEnd();
+        Gfx::color3f(0.2f, 0.9f, 0.2f);
+        Gfx::lineWidth(3.0f);
+        Gfx::begin(GL_LINES);
+        Gfx::vertex2f(x + size * 0.2f, y + size * 0.5f);
+        Gfx::vertex2f(x + size * 0.4f, y + size * 0.2f);
+        Gfx::vertex2f(x + size * 0.4f, y + size * 0.2f);
+        Gfx::vertex2f(x + size * 0.8f, y + size * 0.8f);
+        Gfx::end();
     }
     
     // Label
-    glColor3f(1.0f, 1.0f, 1.0f);
+    Gfx::color3f(1.0f, 1.0f, 1.0f);
     drawText(x + size + 15, y + size / 2 - 8, label, 0.4f);
 }
 
 void Menu::drawSlider(float x, float y, float width, float height,
                       const std::string& label, float value, bool selected) {
     // Label
-    glColor3f(0.8f, 0.8f, 0.8f);
+    Gfx::color3f(0.8f, 0.8f, 0.8f);
     drawText(x, y + height + 5, label, 0.35f);
     
     // Track
-    glColor4f(0.1f, 0.12f, 0.15f, 0.9f);
-    glBegin(GL_QUADS);
-    glVertex2f(x, y); glVertex2f(x + width, y);
-    glVertex2f(x + width, y + height); glVertex2f(x, y + height);
-    glEnd();
+    Gfx::color4f(0.1f, 0.12f, 0.15f, 0.9f);
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(x, y); Gfx::vertex2f(x + width, y);
+    Gfx::vertex2f(x + width, y + height); Gfx::vertex2f(x, y + height);
+    Gfx::end();
     
     // Fill
     if (selected) {
-        glColor4f(0.3f, 0.6f, 0.8f, 0.9f);
+        Gfx::color4f(0.3f, 0.6f, 0.8f, 0.9f);
     } else {
-        glColor4f(0.2f, 0.4f, 0.6f, 0.9f);
+        Gfx::color4f(0.2f, 0.4f, 0.6f, 0.9f);
     }
-    glBegin(GL_QUADS);
-    glVertex2f(x, y); glVertex2f(x + width * value, y);
-    glVertex2f(x + width * value, y + height); glVertex2f(x, y + height);
-    glEnd();
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(x, y); Gfx::vertex2f(x + width * value, y);
+    Gfx::vertex2f(x + width * value, y + height); Gfx::vertex2f(x, y + height);
+    Gfx::end();
     
     // Border
-    glColor3f(0.5f, 0.6f, 0.7f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(x, y); glVertex2f(x + width, y);
-    glVertex2f(x + width, y + height); glVertex2f(x, y + height);
-    glEnd();
+    Gfx::color3f(0.5f, 0.6f, 0.7f);
+    Gfx::lineWidth(2.0f);
+    Gfx::begin(GL_LINE_LOOP);
+    Gfx::vertex2f(x, y); Gfx::vertex2f(x + width, y);
+    Gfx::vertex2f(x + width, y + height); Gfx::vertex2f(x, y + height);
+    Gfx::end();
     
     // Handle
     float handleX = x + width * value;
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(handleX - 5, y - 3);
-    glVertex2f(handleX + 5, y - 3);
-    glVertex2f(handleX + 5, y + height + 3);
-    glVertex2f(handleX - 5, y + height + 3);
-    glEnd();
+    Gfx::color3f(1.0f, 1.0f, 1.0f);
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(handleX - 5, y - 3);
+    Gfx::vertex2f(handleX + 5, y - 3);
+    Gfx::vertex2f(handleX + 5, y + height + 3);
+    Gfx::vertex2f(handleX - 5, y + height + 3);
+    Gfx::end();
 }
 
 void Menu::drawKeybind(float x, float y, float width, float height,
                        const std::string& label, int keyCode, bool selected, bool waiting) {
     // Label
-    glColor3f(0.8f, 0.8f, 0.8f);
+    Gfx::color3f(0.8f, 0.8f, 0.8f);
     drawText(x, y + height / 2 - 8, label, 0.4f);
     
     // Key box
@@ -521,27 +558,27 @@ void Menu::drawKeybind(float x, float y, float width, float height,
     float boxW = 100;
     
     if (waiting) {
-        glColor4f(0.6f, 0.3f, 0.3f, 0.9f);
+        Gfx::color4f(0.6f, 0.3f, 0.3f, 0.9f);
     } else if (selected) {
-        glColor4f(0.3f, 0.5f, 0.7f, 0.9f);
+        Gfx::color4f(0.3f, 0.5f, 0.7f, 0.9f);
     } else {
-        glColor4f(0.15f, 0.2f, 0.25f, 0.9f);
+        Gfx::color4f(0.15f, 0.2f, 0.25f, 0.9f);
     }
     
-    glBegin(GL_QUADS);
-    glVertex2f(boxX, y); glVertex2f(boxX + boxW, y);
-    glVertex2f(boxX + boxW, y + height); glVertex2f(boxX, y + height);
-    glEnd();
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(boxX, y); Gfx::vertex2f(boxX + boxW, y);
+    Gfx::vertex2f(boxX + boxW, y + height); Gfx::vertex2f(boxX, y + height);
+    Gfx::end();
     
-    glColor3f(0.5f, 0.6f, 0.7f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(boxX, y); glVertex2f(boxX + boxW, y);
-    glVertex2f(boxX + boxW, y + height); glVertex2f(boxX, y + height);
-    glEnd();
+    Gfx::color3f(0.5f, 0.6f, 0.7f);
+    Gfx::lineWidth(2.0f);
+    Gfx::begin(GL_LINE_LOOP);
+    Gfx::vertex2f(boxX, y); Gfx::vertex2f(boxX + boxW, y);
+    Gfx::vertex2f(boxX + boxW, y + height); Gfx::vertex2f(boxX, y + height);
+    Gfx::end();
     
     // Key name
-    glColor3f(1.0f, 1.0f, 1.0f);
+    Gfx::color3f(1.0f, 1.0f, 1.0f);
     std::string keyName = waiting ? "..." : getKeyName(keyCode);
     float textW = getTextWidth(keyName, 0.4f);
     drawText(boxX + (boxW - textW) / 2, y + height / 2 - 8, keyName, 0.4f);
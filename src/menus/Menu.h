@@ -3,13 +3,13 @@
 
 #include <string>
 #include <vector>
-#include <map>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
 #include "menus/Settings.h"
 #include "menus/Leaderboard.h"
+#include "menus/TextLayout.h"
 
 struct GLFWwindow;
 
@@ -27,14 +27,6 @@ enum class MenuState {
     LEADERBOARD           // Leaderboard display
 };
 
-// Character info for font rendering
-struct Character {
-    unsigned int textureID;
-    int sizeX, sizeY;
-    int bearingX, bearingY;
-    unsigned int advance;
-};
-
 class Menu {
 public:
     static bool devModeEnabled;
@@ -92,8 +84,11 @@ private:
     // FreeType font rendering
     FT_Library ftLibrary;
     FT_Face ftFace;
-    std::map<char, Character> characters;
+    Character characters[256];        // Indexed by byte, only ASCII is loaded
+    unsigned int fontAtlasTexture;    // All glyphs packed into one texture
+    int fontAtlasWidth, fontAtlasHeight;
     bool fontLoaded;
+    TextLayoutCache textLayouts;      // Laid-out quads for recently drawn strings
     
     bool initFont(const std::string& fontPath);
     void cleanupFont();
@@ -4,6 +4,7 @@
 #include <windows.h>
 #endif
 #include <GL/gl.h>
+#include "Gfx.h"
 #include <GLFW/glfw3.h>
 #include <cmath>
 #include <algorithm>
@@ -30,25 +31,25 @@ void Menu::render(int windowWidth, int windowHeight) {
     
     if (state == MenuState::NONE) return;
     
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
+    Gfx::matrixMode(GL_PROJECTION);
+    Gfx::pushMatrix();
+    Gfx::loadIdentity();
+    Gfx::ortho(0, windowWidth, 0, windowHeight, -1, 1);
     
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    Gfx::matrixMode(GL_MODELVIEW);
+    Gfx::pushMatrix();
+    Gfx::loadIdentity();
     
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    Gfx::disable(GL_DEPTH_TEST);
+    Gfx::enable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Overlay
-    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
-    glBegin(GL_QUADS);
-    glVertex2f(0, 0); glVertex2f(windowWidth, 0);
-    glVertex2f(windowWidth, windowHeight); glVertex2f(0, windowHeight);
-    glEnd();
+    Gfx::color4f(0.0f, 0.0f, 0.0f, 0.7f);
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(0, 0); Gfx::vertex2f(windowWidth, 0);
+    Gfx::vertex2f(windowWidth, windowHeight); Gfx::vertex2f(0, windowHeight);
+    Gfx::end();
     
     float panelWidth = 450.0f;
     float panelHeight = 500.0f;
@@ -66,18 +67,18 @@ void Menu::render(int windowWidth, int windowHeight) {
     float panelY = (windowHeight - panelHeight) / 2.0f;
     
     // Panel
-    glColor4f(0.1f, 0.12f, 0.15f, 0.95f);
-    glBegin(GL_QUADS);
-    glVertex2f(panelX, panelY); glVertex2f(panelX + panelWidth, panelY);
-    glVertex2f(panelX + panelWidth, panelY + panelHeight); glVertex2f(panelX, panelY + panelHeight);
-    glEnd();
-    
-    glColor3f(0.3f, 0.4f, 0.5f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(panelX, panelY); glVertex2f(panelX + panelWidth, panelY);
-    glVertex2f(panelX + panelWidth, panelY + panelHeight); glVertex2f(panelX, panelY + panelHeight);
-    glEnd();
+    Gfx::color4f(0.1f, 0.12f, 0.15f, 0.95f);
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(panelX, panelY); Gfx::vertex2f(panelX + panelWidth, panelY);
+    Gfx::vertex2f(panelX + panelWidth, panelY + panelHeight); Gfx::vertex2f(panelX, panelY + panelHeight);
+    Gfx::end();
+    
+    Gfx::color3f(0.3f, 0.4f, 0.5f);
+    Gfx::lineWidth(2.0f);
+    Gfx::begin(GL_LINE_LOOP);
+    Gfx::vertex2f(panelX, panelY); Gfx::vertex2f(panelX + panelWidth, panelY);
+    Gfx::vertex2f(panelX + panelWidth, panelY + panelHeight); Gfx::vertex2f(panelX, panelY + panelHeight);
+    Gfx::end();
     
     float buttonWidth = 350.0f;
     float buttonHeight = 45.0f;
@@ -85,7 +86,7 @@ void Menu::render(int windowWidth, int windowHeight) {
     float buttonSpacing = 12.0f;
     
     if (state == MenuState::PAUSE) {
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         float titleW = getTextWidth("PAUSED", 0.8f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight - 60, "PAUSED", 0.8f);
         
@@ -96,7 +97,7 @@ void Menu::render(int windowWidth, int windowHeight) {
         }
     }
     else if (state == MenuState::SETTINGS) {
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         float titleW = getTextWidth("SETTINGS", 0.8f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight - 60, "SETTINGS", 0.8f);
         
@@ -107,7 +108,7 @@ void Menu::render(int windowWidth, int windowHeight) {
         }
     }
     else if (state == MenuState::CONTROLS_SETTINGS) {
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         float titleW = getTextWidth("CONTROLS", 0.8f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight - 60, "CONTROLS", 0.8f);
         
@@ -119,7 +120,7 @@ void Menu::render(int windowWidth, int windowHeight) {
         drawSlider(sliderX, startY, sliderWidth, 20, "Sensitivity", sensitivitySlider, controlsSelectedIndex == 0);
         char sensStr[32];
         snprintf(sensStr, sizeof(sensStr), "%.4f", 0.001f + sensitivitySlider * 0.009f);
-        glColor3f(0.7f, 0.7f, 0.7f);
+        Gfx::color3f(0.7f, 0.7f, 0.7f);
         drawText(sliderX + sliderWidth + 15, startY + 5, sensStr, 0.35f);
         
         // Toggle Crouch checkbox
@@ -151,7 +152,7 @@ void Menu::render(int windowWidth, int windowHeight) {
         drawButton(buttonX + halfWidth + 10, btnY, halfWidth, buttonHeight, "Apply", controlsSelectedIndex == 12);
     }
     else if (state == MenuState::GRAPHICS_SETTINGS) {
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         float titleW = getTextWidth("GRAPHICS", 0.8f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight - 60, "GRAPHICS", 0.8f);
         
@@ -169,13 +170,13 @@ void Menu::render(int windowWidth, int windowHeight) {
         // Render Distance slider
         drawSlider(sliderX, startY - 60, sliderWidth, 20, "Render Distance", renderDistanceSlider, graphicsSelectedIndex == 2);
         snprintf(valueStr, sizeof(valueStr), "%.0f", 500.0f + renderDistanceSlider * 9500.0f);
-        glColor3f(0.7f, 0.7f, 0.7f);
+        Gfx::color3f(0.7f, 0.7f, 0.7f);
         drawText(sliderX + sliderWidth + 15, startY - 55, valueStr, 0.35f);
         
         // FOV slider
         drawSlider(sliderX, startY - 120, sliderWidth, 20, "Field of View", fovSlider, graphicsSelectedIndex == 3);
         snprintf(valueStr, sizeof(valueStr), "%.0f", 30.0f + fovSlider * 120.0f);
-        glColor3f(0.7f, 0.7f, 0.7f);
+        Gfx::color3f(0.7f, 0.7f, 0.7f);
         drawText(sliderX + sliderWidth + 15, startY - 115, valueStr, 0.35f);
         
         // Max Framerate slider
@@ -185,13 +186,13 @@ void Menu::render(int windowWidth, int windowHeight) {
         } else {
             snprintf(valueStr, sizeof(valueStr), "%d", 30 + (int)(framerateSlider * 210.0f));
         }
-        glColor3f(0.7f, 0.7f, 0.7f);
+        Gfx::color3f(0.7f, 0.7f, 0.7f);
         drawText(sliderX + sliderWidth + 15, startY - 175, valueStr, 0.35f);
         
         // GUI Scale slider
         drawSlider(sliderX, startY - 240, sliderWidth, 20, "GUI Scale", guiScaleSlider, graphicsSelectedIndex == 5);
         snprintf(valueStr, sizeof(valueStr), "%.1fx", 0.5f + guiScaleSlider * 1.5f);
-        glColor3f(0.7f, 0.7f, 0.7f);
+        Gfx::color3f(0.7f, 0.7f, 0.7f);
         drawText(sliderX + sliderWidth + 15, startY - 235, valueStr, 0.35f);
         
         // Back and Apply buttons at bottom
@@ -201,7 +202,7 @@ void Menu::render(int windowWidth, int windowHeight) {
         drawButton(buttonX + halfWidth + 10, btnY, halfWidth, buttonHeight, "Apply", graphicsSelectedIndex == 6);
     }
     else if (state == MenuState::DIFFICULTY_SETTINGS) {
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         float titleW = getTextWidth("DIFFICULTY", 0.8f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight - 60, "DIFFICULTY", 0.8f);
         
@@ -217,7 +218,7 @@ void Menu::render(int windowWidth, int windowHeight) {
         drawButton(buttonX, backY, buttonWidth, buttonHeight, "Back", (int)difficultyOptions.size() == settingsSelectedIndex);
     }
     else if (state == MenuState::CUSTOM_SETTINGS) {
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         float titleW = getTextWidth("CUSTOM", 0.8f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight - 60, "CUSTOM", 0.8f);
         
@@ -228,17 +229,17 @@ void Menu::render(int windowWidth, int windowHeight) {
         
         drawSlider(sliderX, startY, sliderWidth, 20, "Speed", speedSlider, customSelectedIndex == 0);
         snprintf(valueStr, sizeof(valueStr), "%.1f", 1.0f + speedSlider * 99.0f);
-        glColor3f(0.7f, 0.7f, 0.7f);
+        Gfx::color3f(0.7f, 0.7f, 0.7f);
         drawText(sliderX + sliderWidth + 15, startY + 5, valueStr, 0.35f);
         
         drawSlider(sliderX, startY - 70, sliderWidth, 20, "Gravity", gravitySlider, customSelectedIndex == 1);
         snprintf(valueStr, sizeof(valueStr), "%.1f", -0.3f - gravitySlider * 9.7f);
-        glColor3f(0.7f, 0.7f, 0.7f);
+        Gfx::color3f(0.7f, 0.7f, 0.7f);
         drawText(sliderX + sliderWidth + 15, startY - 65, valueStr, 0.35f);
         
         drawSlider(sliderX, startY - 140, sliderWidth, 20, "Jump Force", jumpSlider, customSelectedIndex == 2);
         snprintf(valueStr, sizeof(valueStr), "%.1f", 8.0f + jumpSlider * 92.0f);
-        glColor3f(0.7f, 0.7f, 0.7f);
+        Gfx::color3f(0.7f, 0.7f, 0.7f);
         drawText(sliderX + sliderWidth + 15, startY - 135, valueStr, 0.35f);
         
         float btnY = startY - 220;
@@ -246,11 +247,11 @@ void Menu::render(int windowWidth, int windowHeight) {
         drawButton(buttonX, btnY - buttonHeight - buttonSpacing, buttonWidth, buttonHeight, "Back", customSelectedIndex == 4);
     }
     else if (state == MenuState::KEYBIND_WAITING) {
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         float titleW = getTextWidth("PRESS A KEY", 0.8f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight / 2, "PRESS A KEY", 0.8f);
         
-        glColor3f(0.6f, 0.6f, 0.6f);
+        Gfx::color3f(0.6f, 0.6f, 0.6f);
         float subW = getTextWidth("(ESC to cancel)", 0.4f);
         drawText(panelX + (panelWidth - subW) / 2.0f, panelY + panelHeight / 2 - 50, "(ESC to cancel)", 0.4f);
     }
@@ -259,21 +260,21 @@ void Menu::render(int windowWidth, int windowHeight) {
         panelY = (windowHeight - panelHeight) / 2.0f;
         
         // Redraw panel with new dimensions
-        glColor4f(0.1f, 0.12f, 0.15f, 0.95f);
-        glBegin(GL_QUADS);
-        glVertex2f(panelX, panelY); glVertex2f(panelX + panelWidth, panelY);
-        glVertex2f(panelX + panelWidth, panelY + panelHeight); glVertex2f(panelX, panelY + panelHeight);
-        glEnd();
-        
-        glColor3f(0.3f, 0.4f, 0.5f);
-        glLineWidth(2.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(panelX, panelY); glVertex2f(panelX + panelWidth, panelY);
-        glVertex2f(panelX + panelWidth, panelY + panelHeight); glVertex2f(panelX, panelY + panelHeight);
-        glEnd();
+        Gfx::color4f(0.1f, 0.12f, 0.15f, 0.95f);
+        Gfx::begin(GL_QUADS);
+        Gfx::vertex2f(panelX, panelY); Gfx::vertex2f(panelX + panelWidth, panelY);
+        Gfx::vertex2f(panelX + panelWidth, panelY + panelHeight); Gfx::vertex2f(panelX, panelY + panelHeight);
+        Gfx::end();
+        
+        Gfx::color3f(0.3f, 0.4f, 0.5f);
+        Gfx::lineWidth(2.0f);
+        Gfx::begin(GL_LINE_LOOP);
+        Gfx::vertex2f(panelX, panelY); Gfx::vertex2f(panelX + panelWidth, panelY);
+        Gfx::vertex2f(panelX + panelWidth, panelY + panelHeight); Gfx::vertex2f(panelX, panelY + panelHeight);
+        Gfx::end();
         
         // Title
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         float titleW = getTextWidth("HELP - CONTROLS", 0.7f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight - 55, "HELP - CONTROLS", 0.7f);
         
@@ -282,25 +283,25 @@ void Menu::render(int windowWidth, int windowHeight) {
         float textY = panelY + panelHeight - 100;
         float lineHeight = 35.0f;
         
-        glColor3f(0.9f, 0.7f, 0.2f);
+        Gfx::color3f(0.9f, 0.7f, 0.2f);
         drawText(textX, textY, "Movement:", 0.45f);
-        glColor3f(0.8f, 0.8f, 0.8f);
+        Gfx::color3f(0.8f, 0.8f, 0.8f);
         drawText(textX + 20, textY - lineHeight, "WASD - Move around", 0.4f);
         drawText(textX + 20, textY - lineHeight * 2, "Space - Jump", 0.4f);
         drawText(textX + 20, textY - lineHeight * 3, "Shift - Crouch", 0.4f);
         drawText(textX + 20, textY - lineHeight * 4, "Mouse - Look around", 0.4f);
         drawText(textX + 20, textY - lineHeight * 5, "Scroll - Zoom camera in/out", 0.4f);
         
-        glColor3f(0.9f, 0.7f, 0.2f);
+        Gfx::color3f(0.9f, 0.7f, 0.2f);
         drawText(textX, textY - lineHeight * 6.5f, "Advanced Movement:", 0.45f);
-        glColor3f(0.4f, 0.9f, 0.4f);
+        Gfx::color3f(0.4f, 0.9f, 0.4f);
         drawText(textX + 20, textY - lineHeight * 7.5f, "Shift+Space - Crouch Jump (lower but faster)", 0.4f);
         drawText(textX + 20, textY - lineHeight * 8.5f, "E + Near Wall - Wall Run (while falling)", 0.4f);
         drawText(textX + 20, textY - lineHeight * 9.5f, "Space (Wall Run) - Wall Jump (jump off wall)", 0.4f);
         
-        glColor3f(0.9f, 0.7f, 0.2f);
+        Gfx::color3f(0.9f, 0.7f, 0.2f);
         drawText(textX, textY - lineHeight * 11.0f, "Other:", 0.45f);
-        glColor3f(0.8f, 0.8f, 0.8f);
+        Gfx::color3f(0.8f, 0.8f, 0.8f);
         drawText(textX + 20, textY - lineHeight * 12.0f, "T - Toggle timer", 0.4f);
         drawText(textX + 20, textY - lineHeight * 13.0f, "R - Reset stats (timer/deaths)", 0.4f);
         drawText(textX + 20, textY - lineHeight * 14.0f, "H - Show this help menu", 0.4f);
@@ -315,26 +316,26 @@ void Menu::render(int windowWidth, int windowHeight) {
         panelY = (windowHeight - panelHeight) / 2.0f;
         
         // Redraw panel with new dimensions
-        glColor4f(0.05f, 0.15f, 0.05f, 0.95f);
-        glBegin(GL_QUADS);
-        glVertex2f(panelX, panelY); glVertex2f(panelX + panelWidth, panelY);
-        glVertex2f(panelX + panelWidth, panelY + panelHeight); glVertex2f(panelX, panelY + panelHeight);
-        glEnd();
-        
-        glColor3f(0.2f, 0.8f, 0.2f);
-        glLineWidth(3.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(panelX, panelY); glVertex2f(panelX + panelWidth, panelY);
-        glVertex2f(panelX + panelWidth, panelY + panelHeight); glVertex2f(panelX, panelY + panelHeight);
-        glEnd();
+        Gfx::color4f(0.05f, 0.15f, 0.05f, 0.95f);
+        Gfx::begin(GL_QUADS);
+        Gfx::vertex2f(panelX, panelY); Gfx::vertex2f(panelX + panelWidth, panelY);
+        Gfx::vertex2f(panelX + panelWidth, panelY + panelHeight); Gfx::vertex2f(panelX, panelY + panelHeight);
+        Gfx::end();
+        
+        Gfx::color3f(0.2f, 0.8f, 0.2f);
+        Gfx::lineWidth(3.0f);
+        Gfx::begin(GL_LINE_LOOP);
+        Gfx::vertex2f(panelX, panelY); Gfx::vertex2f(panelX + panelWidth, panelY);
+        Gfx::vertex2f(panelX + panelWidth, panelY + panelHeight); Gfx::vertex2f(panelX, panelY + panelHeight);
+        Gfx::end();
         
         // Congrats title
-        glColor3f(0.2f, 1.0f, 0.2f);
+        Gfx::color3f(0.2f, 1.0f, 0.2f);
         float titleW = getTextWidth("CONGRATULATIONS!", 0.8f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight - 60, "CONGRATULATIONS!", 0.8f);
         
         // Subtitle
-        glColor3f(0.8f, 1.0f, 0.8f);
+        Gfx::color3f(0.8f, 1.0f, 0.8f);
         float subW = getTextWidth("Course Completed!", 0.5f);
         drawText(panelX + (panelWidth - subW) / 2.0f, panelY + panelHeight - 100, "Course Completed!", 0.5f);
         
@@ -345,19 +346,19 @@ void Menu::render(int windowWidth, int windowHeight) {
         
         char timeStr[64];
         snprintf(timeStr, sizeof(timeStr), "Time: %02d:%02d.%02d", minutes, seconds, milliseconds);
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         float timeW = getTextWidth(timeStr, 0.55f);
         drawText(panelX + (panelWidth - timeW) / 2.0f, panelY + panelHeight - 150, timeStr, 0.55f);
         
         // Deaths display
         char deathStr[32];
         snprintf(deathStr, sizeof(deathStr), "Deaths: %d", completionDeaths);
-        glColor3f(1.0f, 0.6f, 0.6f);
+        Gfx::color3f(1.0f, 0.6f, 0.6f);
         float deathW = getTextWidth(deathStr, 0.45f);
         drawText(panelX + (panelWidth - deathW) / 2.0f, panelY + panelHeight - 185, deathStr, 0.45f);
         
         // Name input label
-        glColor3f(0.9f, 0.9f, 0.2f);
+        Gfx::color3f(0.9f, 0.9f, 0.2f);
         float labelW = getTextWidth("Enter your name:", 0.45f);
         drawText(panelX + (panelWidth - labelW) / 2.0f, panelY + panelHeight - 235, "Enter your name:", 0.45f);
         
@@ -368,30 +369,30 @@ void Menu::render(int windowWidth, int windowHeight) {
         float boxY = panelY + panelHeight - 290;
         
         // Box background
-        glColor4f(0.15f, 0.15f, 0.15f, 0.9f);
-        glBegin(GL_QUADS);
-        glVertex2f(boxX, boxY); glVertex2f(boxX + boxWidth, boxY);
-        glVertex2f(boxX + boxWidth, boxY + boxHeight); glVertex2f(boxX, boxY + boxHeight);
-        glEnd();
+        Gfx::color4f(0.15f, 0.15f, 0.15f, 0.9f);
+        Gfx::begin(GL_QUADS);
+        Gfx::vertex2f(boxX, boxY); Gfx::vertex2f(boxX + boxWidth, boxY);
+        Gfx::vertex2f(boxX + boxWidth, boxY + boxHeight); Gfx::vertex2f(boxX, boxY + boxHeight);
+        Gfx::end();
         
         // Box border
-        glColor3f(0.5f, 0.8f, 0.5f);
-        glLineWidth(2.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(boxX, boxY); glVertex2f(boxX + boxWidth, boxY);
-        glVertex2f(boxX + boxWidth, boxY + boxHeight); glVertex2f(boxX, boxY + boxHeight);
-        glEnd();
+        Gfx::color3f(0.5f, 0.8f, 0.5f);
+        Gfx::lineWidth(2.0f);
+        Gfx::begin(GL_LINE_LOOP);
+        Gfx::vertex2f(boxX, boxY); Gfx::vertex2f(boxX + boxWidth, boxY);
+        Gfx::vertex2f(boxX + boxWidth, boxY + boxHeight); Gfx::vertex2f(boxX, boxY + boxHeight);
+        Gfx::end();
         
         // Name text with cursor
         std::string displayName = playerName;
         if (((int)(completionCountdown * 2)) % 2 == 0) {
             displayName += "_";
         }
-        glColor3f(1.0f, 1.0f, 1.0f);
+        Gfx::color3f(1.0f, 1.0f, 1.0f);
         drawText(boxX + 15, boxY + 12, displayName, 0.45f);
         
         // Countdown display
-        glColor3f(0.6f, 0.6f, 0.6f);
+        Gfx::color3f(0.6f, 0.6f, 0.6f);
         char countdownStr[64];
         int countSecs = (int)completionCountdown + 1;
         snprintf(countdownStr, sizeof(countdownStr), "Restarting in %d seconds...", countSecs);
@@ -399,7 +400,7 @@ void Menu::render(int windowWidth, int windowHeight) {
         drawText(panelX + (panelWidth - countW) / 2.0f, panelY + 40, countdownStr, 0.35f);
         
         // Press Enter hint
-        glColor3f(0.5f, 0.8f, 0.5f);
+        Gfx::color3f(0.5f, 0.8f, 0.5f);
         float hintW = getTextWidth("Press ENTER to save early", 0.35f);
         drawText(panelX + (panelWidth - hintW) / 2.0f, panelY + 70, "Press ENTER to save early", 0.35f);
     }
@@ -408,26 +409,26 @@ void Menu::render(int windowWidth, int windowHeight) {
         panelY = (windowHeight - panelHeight) / 2.0f;
         
         // Redraw panel with new dimensions
-        glColor4f(0.08f, 0.1f, 0.15f, 0.95f);
-        glBegin(GL_QUADS);
-        glVertex2f(panelX, panelY); glVertex2f(panelX + panelWidth, panelY);
-        glVertex2f(panelX + panelWidth, panelY + panelHeight); glVertex2f(panelX, panelY + panelHeight);
-        glEnd();
-        
-        glColor3f(0.4f, 0.6f, 0.9f);
-        glLineWidth(2.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(panelX, panelY); glVertex2f(panelX + panelWidth, panelY);
-        glVertex2f(panelX + panelWidth, panelY + panelHeight); glVertex2f(panelX, panelY + panelHeight);
-        glEnd();
+        Gfx::color4f(0.08f, 0.1f, 0.15f, 0.95f);
+        Gfx::begin(GL_QUADS);
+        Gfx::vertex2f(panelX, panelY); Gfx::vertex2f(panelX + panelWidth, panelY);
+        Gfx::vertex2f(panelX + panelWidth, panelY + panelHeight); Gfx::vertex2f(panelX, panelY + panelHeight);
+        Gfx::end();
+        
+        Gfx::color3f(0.4f, 0.6f, 0.9f);
+        Gfx::lineWidth(2.0f);
+        Gfx::begin(GL_LINE_LOOP);
+        Gfx::vertex2f(panelX, panelY); Gfx::vertex2f(panelX + panelWidth, panelY);
+        Gfx::vertex2f(panelX + panelWidth, panelY + panelHeight); Gfx::vertex2f(panelX, panelY + panelHeight);
+        Gfx::end();
         
         // Title
-        glColor3f(1.0f, 0.85f, 0.2f);
+        Gfx::color3f(1.0f, 0.85f, 0.2f);
         float titleW = getTextWidth("LEADERBOARD", 0.8f);
         drawText(panelX + (panelWidth - titleW) / 2.0f, panelY + panelHeight - 50, "LEADERBOARD", 0.8f);
         
         // Trophy icons
-        glColor3f(1.0f, 0.85f, 0.2f);
+        Gfx::color3f(1.0f, 0.85f, 0.2f);
         drawText(panelX + 30, panelY + panelHeight - 50, "[#]", 0.6f);
         float trophyW = getTextWidth("[#]", 0.6f);
         drawText(panelX + panelWidth - 30 - trophyW, panelY + panelHeight - 50, "[#]", 0.6f);
@@ -439,26 +440,26 @@ void Menu::render(int windowWidth, int windowHeight) {
         float searchHeight = 30;
         
         // Search box background
-        glColor4f(0.12f, 0.14f, 0.18f, 1.0f);
-        glBegin(GL_QUADS);
-        glVertex2f(searchX, searchY); glVertex2f(searchX + searchWidth, searchY);
-        glVertex2f(searchX + searchWidth, searchY + searchHeight); glVertex2f(searchX, searchY + searchHeight);
-        glEnd();
+        Gfx::color4f(0.12f, 0.14f, 0.18f, 1.0f);
+        Gfx::begin(GL_QUADS);
+        Gfx::vertex2f(searchX, searchY); Gfx::vertex2f(searchX + searchWidth, searchY);
+        Gfx::vertex2f(searchX + searchWidth, searchY + searchHeight); Gfx::vertex2f(searchX, searchY + searchHeight);
+        Gfx::end();
         
         // Search box border
-        glColor3f(0.3f, 0.4f, 0.5f);
-        glLineWidth(1.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(searchX, searchY); glVertex2f(searchX + searchWidth, searchY);
-        glVertex2f(searchX + searchWidth, searchY + searchHeight); glVertex2f(searchX, searchY + searchHeight);
-        glEnd();
+        Gfx::color3f(0.3f, 0.4f, 0.5f);
+        Gfx::lineWidth(1.0f);
+        Gfx::begin(GL_LINE_LOOP);
+        Gfx::vertex2f(searchX, searchY); Gfx::vertex2f(searchX + searchWidth, searchY);
+        Gfx::vertex2f(searchX + searchWidth, searchY + searchHeight); Gfx::vertex2f(searchX, searchY + searchHeight);
+        Gfx::end();
         
         // Search text or placeholder
         if (leaderboardSearch.empty()) {
-            glColor3f(0.4f, 0.4f, 0.4f);
+            Gfx::color3f(0.4f, 0.4f, 0.4f);
             drawText(searchX + 10, searchY + 8, "Type to search...", 0.35f);
         } else {
-            glColor3f(1.0f, 1.0f, 1.0f);
+            Gfx::color3f(1.0f, 1.0f, 1.0f);
             std::string displaySearch = leaderboardSearch + "_";
             drawText(searchX + 10, searchY + 8, displaySearch, 0.35f);
         }
@@ -470,19 +471,19 @@ void Menu::render(int windowWidth, int windowHeight) {
         float colTime = panelX + 250;
         float colDeaths = panelX + 370;
         
-        glColor3f(0.6f, 0.7f, 0.8f);
+        Gfx::color3f(0.6f, 0.7f, 0.8f);
         drawText(colRank, headerY, "#", 0.4f);
         drawText(colName, headerY, "Name", 0.4f);
         drawText(colTime, headerY, "Time", 0.4f);
         drawText(colDeaths, headerY, "Deaths", 0.4f);
         
         // Separator line
-        glColor3f(0.3f, 0.4f, 0.5f);
-        glLineWidth(1.0f);
-        glBegin(GL_LINES);
-        glVertex2f(panelX + 20, headerY - 10);
-        glVertex2f(panelX + panelWidth - 20, headerY - 10);
-        glEnd();
+        Gfx::color3f(0.3f, 0.4f, 0.5f);
+        Gfx::lineWidth(1.0f);
+        Gfx::begin(GL_LINES);
+        Gfx::vertex2f(panelX + 20, headerY - 10);
+        Gfx::vertex2f(panelX + panelWidth - 20, headerY - 10);
+        Gfx::end();
         
         // Leaderboard entries
         const auto& entries = leaderboard.getEntries();
@@ -491,7 +492,7 @@ void Menu::render(int windowWidth, int windowHeight) {
         int maxVisible = 10;
         
         if (entries.empty()) {
-            glColor3f(0.5f, 0.5f, 0.5f);
+            Gfx::color3f(0.5f, 0.5f, 0.5f);
             float emptyW = getTextWidth("No entries yet - complete the course!", 0.4f);
             drawText(panelX + (panelWidth - emptyW) / 2.0f, entryY, "No entries yet - complete the course!", 0.4f);
         } else {
@@ -505,21 +506,21 @@ void Menu::render(int windowWidth, int windowHeight) {
                 // Highlight if this is a search match
                 bool isHighlighted = (i == leaderboardHighlight);
                 if (isHighlighted) {
-                    glColor4f(0.2f, 0.4f, 0.6f, 0.5f);
-                    glBegin(GL_QUADS);
-                    glVertex2f(panelX + 25, y - 5);
-                    glVertex2f(panelX + panelWidth - 25, y - 5);
-                    glVertex2f(panelX + panelWidth - 25, y + entryHeight - 8);
-                    glVertex2f(panelX + 25, y + entryHeight - 8);
-                    glEnd();
+                    Gfx::color4f(0.2f, 0.4f, 0.6f, 0.5f);
+                    Gfx::begin(GL_QUADS);
+                    Gfx::vertex2f(panelX + 25, y - 5);
+                    Gfx::vertex2f(panelX + panelWidth - 25, y - 5);
+                    Gfx::vertex2f(panelX + panelWidth - 25, y + entryHeight - 8);
+                    Gfx::vertex2f(panelX + 25, y + entryHeight - 8);
+                    Gfx::end();
                 }
                 
                 // Color based on rank
-                if (isHighlighted) glColor3f(0.3f, 1.0f, 0.3f);
-                else if (i == 0) glColor3f(1.0f, 0.85f, 0.2f);
-                else if (i == 1) glColor3f(0.75f, 0.75f, 0.8f);
-                else if (i == 2) glColor3f(0.8f, 0.5f, 0.2f);
-                else glColor3f(0.8f, 0.8f, 0.8f);
+                if (isHighlighted) Gfx::color3f(0.3f, 1.0f, 0.3f);
+                else if (i == 0) Gfx::color3f(1.0f, 0.85f, 0.2f);
+                else if (i == 1) Gfx::color3f(0.75f, 0.75f, 0.8f);
+                else if (i == 2) Gfx::color3f(0.8f, 0.5f, 0.2f);
+                else Gfx::color3f(0.8f, 0.8f, 0.8f);
                 
                 // Rank
                 char rankStr[16];
@@ -558,13 +559,13 @@ void Menu::render(int windowWidth, int windowHeight) {
             float scrollbarHeight = maxVisible * entryHeight;
             float scrollbarY = scrollbarTop - scrollbarHeight;
             
-            glColor4f(0.2f, 0.2f, 0.25f, 0.8f);
-            glBegin(GL_QUADS);
-            glVertex2f(scrollbarX, scrollbarY);
-            glVertex2f(scrollbarX + 8, scrollbarY);
-            glVertex2f(scrollbarX + 8, scrollbarTop);
-            glVertex2f(scrollbarX, scrollbarTop);
-            glEnd();
+            Gfx::color4f(0.2f, 0.2f, 0.25f, 0.8f);
+            Gfx::begin(GL_QUADS);
+            Gfx::vertex2f(scrollbarX, scrollbarY);
+            Gfx::vertex2f(scrollbarX + 8, scrollbarY);
+            Gfx::vertex2f(scrollbarX + 8, scrollbarTop);
+            Gfx::vertex2f(scrollbarX, scrollbarTop);
+            Gfx::end();
             
             if ((int)entries.size() > maxVisible) {
                 float thumbRatio = (float)maxVisible / entries.size();
@@ -572,27 +573,27 @@ void Menu::render(int windowWidth, int windowHeight) {
                 float scrollRatio = (float)leaderboardScroll / std::max(1, (int)entries.size() - maxVisible);
                 float thumbY = scrollbarTop - thumbHeight - scrollRatio * (scrollbarHeight - thumbHeight);
                 
-                glColor4f(0.5f, 0.6f, 0.8f, 0.9f);
-                glBegin(GL_QUADS);
-                glVertex2f(scrollbarX, thumbY);
-                glVertex2f(scrollbarX + 8, thumbY);
-                glVertex2f(scrollbarX + 8, thumbY + thumbHeight);
-                glVertex2f(scrollbarX, thumbY + thumbHeight);
-                glEnd();
+                Gfx::color4f(0.5f, 0.6f, 0.8f, 0.9f);
+                Gfx::begin(GL_QUADS);
+                Gfx::vertex2f(scrollbarX, thumbY);
+                Gfx::vertex2f(scrollbarX + 8, thumbY);
+                Gfx::vertex2f(scrollbarX + 8, thumbY + thumbHeight);
+                Gfx::vertex2f(scrollbarX, thumbY + thumbHeight);
+                Gfx::end();
             }
             
             // Scroll indicators
             if (leaderboardScroll > 0) {
-                glColor3f(0.5f, 0.7f, 1.0f);
+                Gfx::color3f(0.5f, 0.7f, 1.0f);
                 drawText(panelX + panelWidth - 70, panelY + panelHeight - 130, "^ Scroll", 0.25f);
             }
             if (endIdx < (int)entries.size()) {
-                glColor3f(0.5f, 0.7f, 1.0f);
+                Gfx::color3f(0.5f, 0.7f, 1.0f);
                 drawText(panelX + panelWidth - 70, panelY + 75, "v Scroll", 0.25f);
             }
             
             // Entry count
-            glColor3f(0.5f, 0.5f, 0.5f);
+            Gfx::color3f(0.5f, 0.5f, 0.5f);
             char countStr[64];
             snprintf(countStr, sizeof(countStr), "Showing %d-%d of %d entries", 
                      startIdx + 1, endIdx, (int)entries.size());
@@ -601,39 +602,39 @@ void Menu::render(int windowWidth, int windowHeight) {
         }
         
         // Controls hint
-        glColor3f(0.4f, 0.5f, 0.6f);
+        Gfx::color3f(0.4f, 0.5f, 0.6f);
         drawText(panelX + 25, panelY + 30, "Mouse wheel or Arrow keys to scroll", 0.25f);
         
         // Back button hint
-        glColor3f(0.6f, 0.6f, 0.6f);
+        Gfx::color3f(0.6f, 0.6f, 0.6f);
         float escW = getTextWidth("ESC to close", 0.3f);
         drawText(panelX + panelWidth - escW - 25, panelY + 30, "ESC to close", 0.3f);
     }
     
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
+    Gfx::disable(GL_BLEND);
+    Gfx::enable(GL_DEPTH_TEST);
     
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    Gfx::matrixMode(GL_PROJECTION);
+    Gfx::popMatrix();
+    Gfx::matrixMode(GL_MODELVIEW);
+    Gfx::popMatrix();
 }
 
 void Menu::renderResetPopup(int windowWidth, int windowHeight) {
     float activeTimer = resetFeedbackTimer > 0 ? resetFeedbackTimer : applyFeedbackTimer;
     if (activeTimer <= 0) return;
     
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
+    Gfx::matrixMode(GL_PROJECTION);
+    Gfx::pushMatrix();
+    Gfx::loadIdentity();
+    Gfx::ortho(0, windowWidth, 0, windowHeight, -1, 1);
     
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    Gfx::matrixMode(GL_MODELVIEW);
+    Gfx::pushMatrix();
+    Gfx::loadIdentity();
     
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    Gfx::disable(GL_DEPTH_TEST);
+    Gfx::enable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     float popupWidth = 350.0f;
@@ -654,62 +655,62 @@ void Menu::renderResetPopup(int windowWidth, int windowHeight) {
         iconR = 0.4f; iconG = 0.7f; iconB = 1.0f;
     }
     
-    glColor4f(bgR, bgG, bgB, 0.95f * alpha);
-    glBegin(GL_QUADS);
-    glVertex2f(popupX, popupY);
-    glVertex2f(popupX + popupWidth, popupY);
-    glVertex2f(popupX + popupWidth, popupY + popupHeight);
-    glVertex2f(popupX, popupY + popupHeight);
-    glEnd();
+    Gfx::color4f(bgR, bgG, bgB, 0.95f * alpha);
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(popupX, popupY);
+    Gfx::vertex2f(popupX + popupWidth, popupY);
+    Gfx::vertex2f(popupX + popupWidth, popupY + popupHeight);
+    Gfx::vertex2f(popupX, popupY + popupHeight);
+    Gfx::end();
     
     float pulse = 0.7f + 0.3f * sinf(activeTimer * 8.0f);
-    glColor4f(borderR * pulse, borderG * pulse, borderB * pulse, alpha);
-    glLineWidth(3.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(popupX, popupY);
-    glVertex2f(popupX + popupWidth, popupY);
-    glVertex2f(popupX + popupWidth, popupY + popupHeight);
-    glVertex2f(popupX, popupY + popupHeight);
-    glEnd();
-    
-    glColor4f(iconR, iconG, iconB, alpha);
-    glLineWidth(4.0f);
+    Gfx::color4f(borderR * pulse, borderG * pulse, borderB * pulse, alpha);
+    Gfx::lineWidth(3.0f);
+    Gfx::begin(GL_LINE_LOOP);
+    Gfx::vertex2f(popupX, popupY);
+    Gfx::vertex2f(popupX + popupWidth, popupY);
+    Gfx::vertex2f(popupX + popupWidth, popupY + popupHeight);
+    Gfx::vertex2f(popupX, popupY + popupHeight);
+    Gfx::end();
+    
+    Gfx::color4f(iconR, iconG, iconB, alpha);
+    Gfx::lineWidth(4.0f);
     float checkX = popupX + 30;
     float checkY = popupY + popupHeight / 2;
-    glBegin(GL_LINE_STRIP);
-    glVertex2f(checkX, checkY);
-    glVertex2f(checkX + 10, checkY - 15);
-    glVertex2f(checkX + 30, checkY + 15);
-    glEnd();
+    Gfx::begin(GL_LINE_STRIP);
+    Gfx::vertex2f(checkX, checkY);
+    Gfx::vertex2f(checkX + 10, checkY - 15);
+    Gfx::vertex2f(checkX + 30, checkY + 15);
+    Gfx::end();
     
-    glColor4f(1.0f, 1.0f, 1.0f, alpha);
+    Gfx::color4f(1.0f, 1.0f, 1.0f, alpha);
     float textW = getTextWidth(popupMessage, 0.55f);
     drawText(popupX + (popupWidth - textW) / 2.0f + 15, popupY + popupHeight / 2 - 12, popupMessage, 0.55f);
     
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
+    Gfx::disable(GL_BLEND);
+    Gfx::enable(GL_DEPTH_TEST);
     
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    Gfx::matrixMode(GL_PROJECTION);
+    Gfx::popMatrix();
+    Gfx::matrixMode(GL_MODELVIEW);
+    Gfx::popMatrix();
 }
 
 void Menu::renderCheckpointPopup(int windowWidth, int windowHeight, 
                                   const std::string& message, float timer) {
     if (timer <= 0) return;
     
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
+    Gfx::matrixMode(GL_PROJECTION);
+    Gfx::pushMatrix();
+    Gfx::loadIdentity();
+    Gfx::ortho(0, windowWidth, 0, windowHeight, -1, 1);
     
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    Gfx::matrixMode(GL_MODELVIEW);
+    Gfx::pushMatrix();
+    Gfx::loadIdentity();
     
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    Gfx::disable(GL_DEPTH_TEST);
+    Gfx::enable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     float popupWidth = 380.0f;
@@ -726,66 +727,66 @@ void Menu::renderCheckpointPopup(int windowWidth, int windowHeight,
     float bgR = 0.05f, bgG = 0.25f, bgB = 0.1f;
     float borderR = 0.3f, borderG = 1.0f, borderB = 0.4f;
     
-    glColor4f(bgR, bgG, bgB, 0.9f * alpha);
-    glBegin(GL_QUADS);
-    glVertex2f(popupX, popupY);
-    glVertex2f(popupX + popupWidth, popupY);
-    glVertex2f(popupX + popupWidth, popupY + popupHeight);
-    glVertex2f(popupX, popupY + popupHeight);
-    glEnd();
+    Gfx::color4f(bgR, bgG, bgB, 0.9f * alpha);
+    Gfx::begin(GL_QUADS);
+    Gfx::vertex2f(popupX, popupY);
+    Gfx::vertex2f(popupX + popupWidth, popupY);
+    Gfx::vertex2f(popupX + popupWidth, popupY + popupHeight);
+    Gfx::vertex2f(popupX, popupY + popupHeight);
+    Gfx::end();
     
     float pulse = 0.7f + 0.3f * sinf(timer * 10.0f);
-    glColor4f(borderR * pulse, borderG * pulse, borderB * pulse, alpha);
-    glLineWidth(3.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(popupX, popupY);
-    glVertex2f(popupX + popupWidth, popupY);
-    glVertex2f(popupX + popupWidth, popupY + popupHeight);
-    glVertex2f(popupX, popupY + popupHeight);
-    glEnd();
-    
-    glColor4f(0.3f, 1.0f, 0.5f, alpha);
+    Gfx::color4f(borderR * pulse, borderG * pulse, borderB * pulse, alpha);
+    Gfx::lineWidth(3.0f);
+    Gfx::begin(GL_LINE_LOOP);
+    Gfx::vertex2f(popupX, popupY);
+    Gfx::vertex2f(popupX + popupWidth, popupY);
+    Gfx::vertex2f(popupX + popupWidth, popupY + popupHeight);
+    Gfx::vertex2f(popupX, popupY + popupHeight);
+    Gfx::end();
+    
+    Gfx::color4f(0.3f, 1.0f, 0.5f, alpha);
     float flagX = popupX + 30;
     float flagY = popupY + popupHeight / 2;
-    glLineWidth(3.0f);
-    glBegin(GL_LINES);
-    glVertex2f(flagX, flagY - 20);
-    glVertex2f(flagX, flagY + 20);
-    glEnd();
-    glBegin(GL_TRIANGLES);
-    glVertex2f(flagX, flagY + 20);
-    glVertex2f(flagX + 20, flagY + 10);
-    glVertex2f(flagX, flagY);
-    glEnd();
-    
-    glColor4f(1.0f, 1.0f, 1.0f, alpha);
+    Gfx::lineWidth(3.0f);
+    Gfx::begin(GL_LINES);
+    Gfx::vertex2f(flagX, flagY - 20);
+    Gfx::vertex2f(flagX, flagY + 20);
+    Gfx::end();
+    Gfx::begin(GL_TRIANGLES);
+    Gfx::vertex2f(flagX, flagY + 20);
+    Gfx::vertex2f(flagX + 20, flagY + 10);
+    Gfx::vertex2f(flagX, flagY);
+    Gfx::end();
+    
+    Gfx::color4f(1.0f, 1.0f, 1.0f, alpha);
     float textW = getTextWidth(message, 0.55f);
     drawText(popupX + (popupWidth - textW) / 2.0f + 15, popupY + popupHeight / 2 - 12, message, 0.55f);
     
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
+    Gfx::disable(GL_BLEND);
+    Gfx::enable(GL_DEPTH_TEST);
     
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    Gfx::matrixMode(GL_PROJECTION);
+    Gfx::popMatrix();
+    Gfx::matrixMode(GL_MODELVIEW);
+    Gfx::popMatrix();
 }
 
 void Menu::renderHUD(int windowWidth, int windowHeight, float timer, int deaths,
                      bool timerRunning, bool timerFinished) {
     if (!fontLoaded) return;
     
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, windowWidth, 0, windowHeight, -1, 1);
+    Gfx::matrixMode(GL_PROJECTION);
+    Gfx::pushMatrix();
+    Gfx::loadIdentity();
+    Gfx::ortho(0, windowWidth, 0, windowHeight, -1, 1);
     
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    Gfx::matrixMode(GL_MODELVIEW);
+    Gfx::pushMatrix();
+    Gfx::loadIdentity();
     
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    Gfx::disable(GL_DEPTH_TEST);
+    Gfx::enable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     float scale = 0.5f;
@@ -798,37 +799,37 @@ void Menu::renderHUD(int windowWidth, int windowHeight, float timer, int deaths,
     char timerStr[32];
     snprintf(timerStr, sizeof(timerStr), "%02d:%02d.%02d", minutes, seconds, milliseconds);
     
-    if (timerFinished) glColor3f(0.2f, 1.0f, 0.2f);
-    else if (timerRunning) glColor3f(1.0f, 1.0f, 1.0f);
-    else glColor3f(0.6f, 0.6f, 0.6f);
+    if (timerFinished) Gfx::color3f(0.2f, 1.0f, 0.2f);
+    else if (timerRunning) Gfx::color3f(1.0f, 1.0f, 1.0f);
+    else Gfx::color3f(0.6f, 0.6f, 0.6f);
     
     drawText(padding, windowHeight - padding - 30, timerStr, scale);
     
     if (!timerRunning && !timerFinished) {
-        glColor3f(0.5f, 0.5f, 0.5f);
+        Gfx::color3f(0.5f, 0.5f, 0.5f);
         drawText(padding, windowHeight - padding - 60, "[T] Start  [R] Reset", 0.35f);
     } else if (timerRunning) {
-        glColor3f(0.5f, 0.5f, 0.5f);
+        Gfx::color3f(0.5f, 0.5f, 0.5f);
         drawText(padding, windowHeight - padding - 60, "[T] Pause  [R] Reset", 0.35f);
     } else if (timerFinished) {
-        glColor3f(0.2f, 1.0f, 0.2f);
+        Gfx::color3f(0.2f, 1.0f, 0.2f);
         drawText(padding, windowHeight - padding - 60, "GOAL REACHED!", 0.35f);
     }
     
     char deathStr[32];
     snprintf(deathStr, sizeof(deathStr), "Deaths: %d", deaths);
-    glColor3f(1.0f, 0.4f, 0.4f);
+    Gfx::color3f(1.0f, 0.4f, 0.4f);
     float deathWidth = getTextWidth(deathStr, scale);
     drawText(windowWidth - padding - deathWidth, windowHeight - padding - 30, deathStr, scale);
     
-    glColor3f(0.4f, 0.4f, 0.4f);
+    Gfx::color3f(0.4f, 0.4f, 0.4f);
     drawText(padding, padding + 10, "[H] Help  [L] Leaderboard", 0.3f);
     
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
+    Gfx::disable(GL_BLEND);
+    Gfx::enable(GL_DEPTH_TEST);
     
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    Gfx::matrixMode(GL_PROJECTION);
+    Gfx::popMatrix();
+    Gfx::matrixMode(GL_MODELVIEW);
+    Gfx::popMatrix();
 }
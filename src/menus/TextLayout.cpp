@@ -0,0 +1,80 @@
+#include "TextLayout.h"
+#include <cstring>
+
+TextLayoutCache::TextLayoutCache(size_t capacity)
+    : capacity(capacity), cachedGuiScale(0.0f) {
+}
+
+std::string TextLayoutCache::makeKey(const std::string& text, float scale) {
+    // Text followed by the raw bits of the scale
+    std::string key = text;
+    char bits[sizeof(float)];
+    memcpy(bits, &scale, sizeof(float));
+    key.push_back('\0');
+    key.append(bits, sizeof(float));
+    return key;
+}
+
+void TextLayoutCache::layoutText(const std::string& text, float scale, const Character* glyphs,
+                                 TextLayout& out) {
+    out.vertices.clear();
+    out.vertices.reserve(text.size() * 16);
+    
+    float x = 0.0f;
+    for (char c : text) {
+        const Character& ch = glyphs[(unsigned char)c];
+        if (!ch.loaded) continue;
+        
+        float xpos = x + ch.bearingX * scale;
+        float ypos = -(ch.sizeY - ch.bearingY) * scale;
+        float w = ch.sizeX * scale;
+        float h = ch.sizeY * scale;
+        
+        const float quad[16] = {
+            xpos,     ypos + h, ch.u0, ch.v0,
+            xpos + w, ypos + h, ch.u1, ch.v0,
+            xpos + w, ypos,     ch.u1, ch.v1,
+            xpos,     ypos,     ch.u0, ch.v1
+        };
+        out.vertices.insert(out.vertices.end(), quad, quad + 16);
+        
+        x += (ch.advance >> 6) * scale;
+    }
+    out.width = x;
+}
+
+const TextLayout& TextLayoutCache::get(const std::string& text, float scale, float guiScale,
+                                       const Character* glyphs) {
+    // Every cached quad was built with the old GUI scale
+    if (guiScale != cachedGuiScale) {
+        clear();
+        cachedGuiScale = guiScale;
+    }
+    
+    std::string key = makeKey(text, scale);
+    auto it = lookup.find(key);
+    if (it != lookup.end()) {
+        // Hit: move to the front of the LRU list
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->layout;
+    }
+    
+    // Miss: evict the least recently used entry if full
+    if (entries.size() >= capacity && !entries.empty()) {
+        lookup.erase(entries.back().key);
+        entries.pop_back();
+    }
+    
+    entries.push_front(Entry());
+    Entry& entry = entries.front();
+    entry.key = key;
+    layoutText(text, scale * guiScale, glyphs, entry.layout);
+    lookup[key] = entries.begin();
+    
+    return entry.layout;
+}
+
+void TextLayoutCache::clear() {
+    entries.clear();
+    lookup.clear();
+}
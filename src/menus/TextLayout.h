@@ -0,0 +1,56 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Character info for font rendering
+struct Character {
+    bool loaded;                // Glyph exists in the atlas
+    int sizeX, sizeY;
+    int bearingX, bearingY;
+    unsigned int advance;
+    float u0, v0, u1, v1;       // UV rect inside the glyph atlas
+};
+
+// Laid-out string: one textured quad per glyph, relative to the pen origin
+struct TextLayout {
+    std::vector<float> vertices;  // x, y, u, v per vertex, 4 vertices per glyph
+    float width;                  // Total advance in pixels
+    
+    int vertexCount() const { return (int)(vertices.size() / 4); }
+};
+
+// LRU cache of laid-out strings keyed by (text, scale)
+// Entries are laid out for one GUI scale; changing it drops the whole cache.
+class TextLayoutCache {
+public:
+    explicit TextLayoutCache(size_t capacity = 256);
+    
+    // Returns the cached layout, building it on a miss
+    const TextLayout& get(const std::string& text, float scale, float guiScale,
+                          const Character* glyphs);
+    
+    void clear();
+    size_t size() const { return entries.size(); }
+    
+private:
+    struct Entry {
+        std::string key;
+        TextLayout layout;
+    };
+    
+    size_t capacity;
+    float cachedGuiScale;
+    std::list<Entry> entries;  // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> lookup;
+    
+    static std::string makeKey(const std::string& text, float scale);
+    static void layoutText(const std::string& text, float scale, const Character* glyphs,
+                           TextLayout& out);
+};
+
+#endif // TEXT_LAYOUT_H